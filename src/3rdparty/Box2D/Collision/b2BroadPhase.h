@@ -80,6 +80,10 @@ public:
 	template <typename T>
 	void Query(T* callback, const b2AABB& aabb) const;
 
+	/// Query many AABBs with a single traversal. See b2DynamicTree::QueryBatch.
+	template <typename T>
+	void QueryBatch(T* callback, const b2AABB* aabbs, int32 count) const;
+
 	/// Ray-cast against the proxies in the tree. This relies on the callback
 	/// to perform a exact ray-cast in the case were the proxy contains a shape.
 	/// The callback also performs the any collision filtering. This has performance
@@ -245,6 +249,12 @@ inline void b2BroadPhase::Query(T* callback, const b2AABB& aabb) const
 	m_tree.Query(callback, aabb);
 }
 
+template <typename T>
+inline void b2BroadPhase::QueryBatch(T* callback, const b2AABB* aabbs, int32 count) const
+{
+	m_tree.QueryBatch(callback, aabbs, count);
+}
+
 template <typename T>
 inline void b2BroadPhase::RayCast(T* callback, const b2RayCastInput& input) const
 {
@@ -795,7 +795,9 @@ void b2DynamicTree::ShiftOrigin(const b2Vec2& newOrigin)
 
 b2DynamicTree& b2DynamicTree::operator=(const b2DynamicTree& b) 
 {
-	this->~b2DynamicTree();
+	if (this == &b) {
+		return *this;
+	}
 
 	const auto bytes = b.m_nodeCapacity * sizeof(b2TreeNode);
 #if DEBUG_PHYSICS_WORLD_CACHE_COPY
@@ -806,7 +808,16 @@ b2DynamicTree& b2DynamicTree::operator=(const b2DynamicTree& b)
 #endif
 #endif
 
-	m_nodes = (b2TreeNode*)b2Alloc(static_cast<int32>(bytes));
+	/* 
+		Repeated copies between the same trees (e.g. during reprediction) 
+		almost always have the same capacity, so reuse the buffer if possible.
+	*/
+
+	if (m_nodes == nullptr || m_nodeCapacity != b.m_nodeCapacity) {
+		this->~b2DynamicTree();
+		m_nodes = (b2TreeNode*)b2Alloc(static_cast<int32>(bytes));
+	}
+
 	memcpy(m_nodes, b.m_nodes, bytes);
 
 	m_root = b.m_root;
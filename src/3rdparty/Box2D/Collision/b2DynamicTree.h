@@ -19,6 +19,8 @@
 #ifndef B2_DYNAMIC_TREE_H
 #define B2_DYNAMIC_TREE_H
 
+#include <bit>
+#include <cstdint>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Common/b2GrowableStack.h>
 
@@ -99,6 +101,14 @@ public:
 	template <typename T>
 	void Query(T* callback, const b2AABB& aabb) const;
 
+	/// Query many AABBs in a single traversal of the tree.
+	/// The callback's QueryCallback(proxyId, queryIndex) is called for each pair
+	/// of an overlapping proxy and query, in ascending order of queryIndex.
+	/// For every single query, the proxies are reported in the same order as by Query.
+	/// Returning false stops only the query with this index.
+	template <typename T>
+	void QueryBatch(T* callback, const b2AABB* aabbs, int32 count) const;
+
 	template <typename T>
 	void QueryAll(T* callback) const;
 
@@ -261,6 +271,73 @@ inline void b2DynamicTree::Query(T* callback, const b2AABB& aabb) const
 	}
 }
 
+template <typename T>
+inline void b2DynamicTree::QueryBatch(T* callback, const b2AABB* aabbs, int32 count) const
+{
+	/* Every stack entry carries the mask of queries overlapping all of its ancestors. */
+
+	struct entry
+	{
+		int32 nodeId;
+		std::uint64_t mask;
+	};
+
+	for (int32 first = 0; first < count; first += 64)
+	{
+		const int32 n = b2Min(count - first, 64);
+		std::uint64_t alive = n == 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << n) - 1);
+
+		b2GrowableStack<entry, 256> stack;
+		stack.Push({ m_root, alive });
+
+		while (stack.GetCount() > 0 && alive != 0)
+		{
+			const entry current = stack.Pop();
+			if (current.nodeId == b2_nullNode)
+			{
+				continue;
+			}
+
+			const b2TreeNode* node = m_nodes + current.nodeId;
+
+			std::uint64_t overlapping = 0;
+
+			for (std::uint64_t rest = current.mask & alive; rest != 0; rest &= rest - 1)
+			{
+				const int32 i = std::countr_zero(rest);
+
+				if (b2TestOverlap(node->aabb, aabbs[first + i]))
+				{
+					overlapping |= std::uint64_t(1) << i;
+				}
+			}
+
+			if (overlapping == 0)
+			{
+				continue;
+			}
+
+			if (node->IsLeaf())
+			{
+				for (std::uint64_t rest = overlapping; rest != 0; rest &= rest - 1)
+				{
+					const int32 i = std::countr_zero(rest);
+
+					if (!callback->QueryCallback(current.nodeId, first + i))
+					{
+						alive &= ~(std::uint64_t(1) << i);
+					}
+				}
+			}
+			else
+			{
+				stack.Push({ node->child1, overlapping });
+				stack.Push({ node->child2, overlapping });
+			}
+		}
+	}
+}
+
 template <typename T>
 inline void b2DynamicTree::RayCast(T* callback, const b2RayCastInput& input) const
 {
@@ -21,6 +21,7 @@
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <utility>
 
 #include "augs/build_settings/setting_debug_physics_world_cache_copy.h"
 
@@ -229,3 +230,40 @@ void b2BlockAllocator::Clear()
 
 	memset(m_freeLists, 0, sizeof(m_freeLists));
 }
+
+void b2BlockAllocator::FreeAll()
+{
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		b2Chunk* chunk = m_chunks + i;
+		int32 blockSize = chunk->blockSize;
+		int32 index = s_blockSizeLookup[blockSize];
+		int32 blockCount = b2_chunkSize / blockSize;
+
+		// Push in reverse so that blocks are handed out in address order.
+		for (int32 j = blockCount - 1; j >= 0; --j)
+		{
+			b2Block* block = (b2Block*)((int8*)chunk->blocks + blockSize * j);
+			block->next = m_freeLists[index];
+			m_freeLists[index] = block;
+		}
+	}
+
+#if DEBUG_PHYSICS_WORLD_CACHE_COPY
+	m_numAllocatedObjects = 0;
+#endif
+}
+
+void b2BlockAllocator::Swap(b2BlockAllocator& other)
+{
+	std::swap(m_chunks, other.m_chunks);
+	std::swap(m_chunkCount, other.m_chunkCount);
+	std::swap(m_chunkSpace, other.m_chunkSpace);
+	std::swap(m_freeLists, other.m_freeLists);
+
+#if DEBUG_PHYSICS_WORLD_CACHE_COPY
+	std::swap(m_numAllocatedObjects, other.m_numAllocatedObjects);
+#endif
+}
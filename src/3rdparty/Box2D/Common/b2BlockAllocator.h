@@ -47,6 +47,13 @@ public:
 
 	void Clear();
 
+	/// Return all blocks to the free lists but keep the chunks,
+	/// so that the allocator can be refilled without touching the heap.
+	void FreeAll();
+
+	/// Exchange chunks and free lists with another allocator.
+	void Swap(b2BlockAllocator& other);
+
 	b2BlockAllocator& operator=(const b2BlockAllocator&) {
 		return *this;
 	}
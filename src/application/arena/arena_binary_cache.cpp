@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <filesystem>
+
+#include "augs/misc/pool/pool_io.hpp"
+#include "augs/readwrite/memory_stream.h"
+
+#include "application/intercosm.h"
+#include "game/organization/all_component_includes.h"
+#include "game/cosmos/change_common_significant.hpp"
+#include "game/cosmos/change_solvable_significant.h"
+
+#include "application/arena/arena_binary_cache.h"
+
+#include "augs/log.h"
+#include "augs/misc/secure_hash.h"
+#include "augs/filesystem/file.h"
+#include "augs/filesystem/directory.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/readwrite/to_bytes.h"
+#include "hypersomnia_version.h"
+#include "all_paths.h"
+
+#define ARENA_BINARY_CACHE_DIR (CACHE_DIR / "arenas")
+
+/*
+	Bump whenever the layout of the cache changes in a way not covered by the commit hash,
+	e.g. in development builds where the commit stays the same.
+*/
+
+constexpr uint32_t arena_binary_cache_version = 1;
+
+/*
+	Every edit of a rotated map leaves its old entry behind,
+	so the least recently used entries are removed past this size.
+*/
+
+constexpr uint64_t max_arena_binary_cache_bytes = 512ull * 1024 * 1024;
+
+augs::path_type get_arena_binary_cache_path(const augs::secure_hash_type& arena_hash) {
+	return ARENA_BINARY_CACHE_DIR / (std::string(augs::to_hex_format(arena_hash)) + ".bin");
+}
+
+bool read_arena_binary_cache(
+	const augs::path_type& cache_path,
+	const game_mode_name_type& override_game_mode,
+	online_arena_handle<false> handle,
+	cosmos_solvable_significant& clean_round_state,
+	editor_project_readwrite::external_resource_database& external_resources
+) {
+	if (!augs::exists(cache_path)) {
+		return false;
+	}
+
+	try {
+		const auto bytes = augs::file_to_bytes(cache_path);
+		auto s = augs::make_ptr_read_stream(bytes);
+
+		uint32_t version = 0;
+		std::string commit_hash;
+		game_mode_name_type cached_override_game_mode;
+
+		augs::read_bytes(s, version);
+
+		if (version != arena_binary_cache_version) {
+			return false;
+		}
+
+		augs::read_bytes(s, commit_hash);
+		augs::read_bytes(s, cached_override_game_mode);
+
+		if (commit_hash != hypersomnia_version().commit_hash || cached_override_game_mode != override_game_mode) {
+			return false;
+		}
+
+		auto& scene = handle.scene;
+
+		scene.world.change_common_significant([&](cosmos_common_significant& common) {
+			augs::read_bytes(s, common);
+			return changer_callback_result::DONT_REFRESH;
+		});
+
+		cosmic::change_solvable_significant(scene.world, [&](cosmos_solvable_significant& significant) {
+			augs::read_bytes(s, significant);
+			return changer_callback_result::DONT_REFRESH;
+		});
+
+		augs::read_bytes(s, scene.viewables);
+
+		all_rulesets_variant ruleset;
+		augs::read_bytes(s, ruleset);
+
+		uint32_t num_resources = 0;
+		augs::read_bytes(s, num_resources);
+
+		external_resources.clear();
+
+		for (uint32_t i = 0; i < num_resources; ++i) {
+			std::string path;
+			augs::secure_hash_type hash;
+
+			augs::read_bytes(s, path);
+			augs::read_bytes(s, hash);
+
+			external_resources.emplace_back(path, hash);
+		}
+
+		if (s.get_read_pos() != bytes.size()) {
+			LOG("Trailing bytes in %x. Rebuilding the arena.", cache_path);
+			return false;
+		}
+
+		handle.choose_mode(ruleset);
+		scene.post_load_state_correction();
+
+		clean_round_state = scene.world.get_solvable().significant;
+
+		/* Mark the entry as recently used for trim_arena_binary_cache. */
+		std::error_code err;
+		std::filesystem::last_write_time(cache_path, std::filesystem::file_time_type::clock::now(), err);
+
+		return true;
+	}
+	catch (const std::exception& err) {
+		/*
+			The scene might be half-read at this point,
+			but it is rebuilt from scratch by the caller anyway.
+		*/
+
+		LOG("Failed to read the arena binary cache from %x: %x", cache_path, err.what());
+		return false;
+	}
+}
+
+static void trim_arena_binary_cache(const uint64_t max_bytes) {
+	struct entry {
+		augs::path_type path;
+		std::filesystem::file_time_type used_when;
+		uint64_t size = 0;
+	};
+
+	std::vector<entry> entries;
+
+	try {
+		if (!augs::exists(ARENA_BINARY_CACHE_DIR)) {
+			return;
+		}
+
+		auto skip_directory = [](auto&&...) { return callback_result::CONTINUE; };
+
+		augs::for_each_in_directory(
+			ARENA_BINARY_CACHE_DIR,
+			skip_directory,
+			[&](const augs::path_type& p) {
+				if (p.extension() == ".bin") {
+					entries.push_back({ p, augs::last_write_time(p), static_cast<uint64_t>(augs::get_file_size(p)) });
+				}
+
+				return callback_result::CONTINUE;
+			}
+		);
+	}
+	catch (...) {
+		return;
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+		return a.used_when > b.used_when;
+	});
+
+	uint64_t total_bytes = 0;
+
+	for (const auto& e : entries) {
+		total_bytes += e.size;
+
+		if (total_bytes > max_bytes) {
+			LOG("Removing the least recently used arena binary cache: %x", e.path);
+			augs::remove_file(e.path);
+		}
+	}
+}
+
+void write_arena_binary_cache(
+	const augs::path_type& cache_path,
+	const game_mode_name_type& override_game_mode,
+	const online_arena_handle<false> handle,
+	const editor_project_readwrite::external_resource_database& external_resources
+) {
+	const auto& scene = handle.scene;
+
+	std::vector<std::byte> bytes;
+
+	{
+		auto s = augs::ref_memory_stream(bytes);
+
+		augs::write_bytes(s, arena_binary_cache_version);
+		augs::write_bytes(s, hypersomnia_version().commit_hash);
+		augs::write_bytes(s, override_game_mode);
+
+		augs::write_bytes(s, scene.world.get_common_significant());
+		augs::write_bytes(s, scene.world.get_solvable().significant);
+		augs::write_bytes(s, scene.viewables);
+		augs::write_bytes(s, handle.ruleset);
+
+		augs::write_bytes(s, static_cast<uint32_t>(external_resources.size()));
+
+		for (const auto& resource : external_resources) {
+			augs::write_bytes(s, resource.first.string());
+			augs::write_bytes(s, resource.second);
+		}
+	}
+
+	try {
+		augs::create_directories_for(cache_path);
+		augs::bytes_to_file(bytes, cache_path);
+
+		LOG("Wrote the arena binary cache to %x (%x bytes).", cache_path, bytes.size());
+	}
+	catch (const std::exception& err) {
+		/* The cache is only an optimization. */
+		LOG("Failed to write the arena binary cache to %x: %x", cache_path, err.what());
+	}
+
+	trim_arena_binary_cache(max_arena_binary_cache_bytes);
+}
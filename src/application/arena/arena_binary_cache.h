@@ -0,0 +1,35 @@
+#pragma once
+#include "augs/filesystem/path_declaration.h"
+#include "augs/network/network_types.h"
+#include "application/network/network_common.h"
+#include "application/setups/editor/project/editor_project_readwrite.h"
+
+/*
+	The result of build_arena_from_editor_project, saved in binary form.
+
+	Parsing the project json and rebuilding every node takes long enough
+	to freeze the tick loop of a server that rotates maps.
+	The cache is keyed by the arena hash and is stale whenever the game version,
+	the format version or the overridden game mode does not match.
+
+	Reading never throws. A missing, stale or corrupt cache only means the arena is built from the project again.
+*/
+
+struct cosmos_solvable_significant;
+
+augs::path_type get_arena_binary_cache_path(const augs::secure_hash_type& arena_hash);
+
+bool read_arena_binary_cache(
+	const augs::path_type& cache_path,
+	const game_mode_name_type& override_game_mode,
+	online_arena_handle<false> handle,
+	cosmos_solvable_significant& clean_round_state,
+	editor_project_readwrite::external_resource_database& external_resources
+);
+
+void write_arena_binary_cache(
+	const augs::path_type& cache_path,
+	const game_mode_name_type& override_game_mode,
+	online_arena_handle<false> handle,
+	const editor_project_readwrite::external_resource_database& external_resources
+);
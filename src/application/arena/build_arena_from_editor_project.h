@@ -22,3 +22,15 @@ struct build_arena_input {
 
 template <class A>
 void build_arena_from_editor_project(A arena_handle, build_arena_input);
+
+/*
+	Refreshes only the entities backing the given nodes after their properties or transforms were edited.
+	The entities keep their ids and sorting order, and only their caches are reinferred.
+
+	Returns false without touching the scene if any of the nodes can't be refreshed in place,
+	e.g. prefabs, nodes that generate equipment or portals which depend on other nodes.
+	The caller should then do the full build.
+*/
+
+template <class A>
+bool rebuild_arena_nodes_in_place(A arena_handle, build_arena_input, const std::vector<editor_node_id>& nodes);
@@ -1,4 +1,6 @@
 #pragma once
+#include <unordered_map>
+#include "augs/templates/container_templates.h"
 #include "game/cosmos/per_entity_type.h"
 #include "application/setups/editor/project/editor_project.hpp"
 #include "application/setups/editor/editor_rebuild_prefab_nodes.hpp"
@@ -479,3 +481,172 @@ void build_arena_from_editor_project(A arena_handle, const build_arena_input in)
 		*in.target_clean_round_state = scene.world.get_solvable().significant;
 	}
 }
+
+template <class A>
+bool rebuild_arena_nodes_in_place(A arena_handle, const build_arena_input in, const std::vector<editor_node_id>& nodes) {
+	const auto& project = in.project;
+	const auto& official = in.official;
+
+	auto find_resource = project.make_find_resource_lambda(official.resources);
+
+	auto get_asset_id_of = [&]<typename R>(const editor_typed_resource_id<R>& resource_id) {
+		using asset_type = decltype(R::scene_asset_id);
+
+		if (const auto resource = find_resource(resource_id)) {
+			return resource->scene_asset_id;
+		}
+
+		return asset_type();
+	};
+
+	auto get_scene_flavour_id = [&]<typename N, typename R>(const N& typed_node, const R& resource) {
+		if constexpr(has_custom_scene_flavour_id_v<N>) {
+			if (typed_node.custom_scene_flavour_id.has_value()) {
+				return *typed_node.custom_scene_flavour_id;
+			}
+		}
+
+		return resource.scene_flavour_id;
+	};
+
+	auto& cosm = arena_handle.scene.world;
+
+	thread_local std::unordered_map<editor_node_id, const editor_layer*> layer_of;
+	layer_of.clear();
+
+	for (const auto& node_id : nodes) {
+		layer_of.emplace(node_id, nullptr);
+	}
+
+	for (const auto layer_id : project.layers.order) {
+		if (const auto layer = project.find_layer(layer_id)) {
+			for (const auto& node_id : layer->hierarchy.nodes) {
+				if (const auto found = mapped_or_nullptr(layer_of, node_id)) {
+					*found = layer;
+				}
+			}
+		}
+	}
+
+	/*
+		First only check if all nodes can be refreshed in place,
+		so that we never leave the scene half-refreshed when falling back to the full build.
+	*/
+
+	bool all_refreshable = true;
+
+	for (const auto& node_id : nodes) {
+		project.on_node(node_id, [&]<typename node_type>(const node_type& typed_node, const auto) {
+			if constexpr(is_one_of_v<node_type, editor_prefab_node, editor_firearm_node, editor_melee_node, editor_explosive_node, editor_tool_node, editor_ammunition_node>) {
+				/* Prefabs have children and equipment needs a logic step to be generated. */
+				all_refreshable = false;
+			}
+			else {
+				const auto handle = cosm[typed_node.scene_entity_id];
+				const auto layer = layer_of[node_id];
+
+				const bool should_exist = layer != nullptr && layer->is_active() && typed_node.active;
+
+				if (handle.alive() != should_exist) {
+					/* The node was toggled, so its entity has to be created or deleted. */
+					all_refreshable = false;
+					return;
+				}
+
+				if (handle.dead()) {
+					/* Inactive node, nothing to refresh. */
+					return;
+				}
+
+				const auto resource = find_resource(typed_node.resource_id);
+
+				if (resource == nullptr) {
+					all_refreshable = false;
+					return;
+				}
+
+				std::visit(
+					[&](const auto& typed_flavour_id) {
+						if (handle.get_flavour_id() != entity_flavour_id(typed_flavour_id)) {
+							/* E.g. a custom flavour was chosen. A different entity type has to be created. */
+							all_refreshable = false;
+						}
+					},
+					get_scene_flavour_id(typed_node, *resource)
+				);
+
+				if constexpr(std::is_same_v<node_type, editor_area_marker_node>) {
+					if (::is_portal_based(resource->editable.type)) {
+						/* Has a per-node flavour and depends on other nodes. */
+						all_refreshable = false;
+					}
+				}
+			}
+		});
+
+		if (!all_refreshable) {
+			return false;
+		}
+	}
+
+	for (const auto& node_id : nodes) {
+		project.on_node(node_id, [&]<typename node_type>(const node_type& typed_node, const auto) {
+			if constexpr(!is_one_of_v<node_type, editor_prefab_node, editor_firearm_node, editor_melee_node, editor_explosive_node, editor_tool_node, editor_ammunition_node>) {
+				const auto handle = cosm[typed_node.scene_entity_id];
+
+				if (handle.dead()) {
+					return;
+				}
+
+				const auto& resource = *find_resource(typed_node.resource_id);
+				const auto& layer = *layer_of[node_id];
+
+				std::visit([&](const auto& typed_flavour_id) {
+					using E = typename remove_cref<decltype(typed_flavour_id)>::used_entity_type;
+
+					const auto typed_handle = handle.template get_specific<E>();
+					auto& agg = typed_handle.get({});
+
+					/* Keep the order assigned by the full build. */
+					auto total_order = sorting_order_type(0);
+
+					if (const auto sorting_order = agg.template find<components::sorting_order>()) {
+						total_order = sorting_order->order;
+					}
+
+					cosmic::destroy_caches_of(typed_handle);
+
+					agg.component_state = typed_handle.get_flavour().initial_components;
+					agg.when_born.step = 0;
+
+					::setup_entity_from_node(
+						get_asset_id_of,
+						find_resource,
+						total_order,
+						layer,
+						typed_node,
+						resource,
+						typed_handle,
+						agg
+					);
+
+					construct_pre_inference(typed_handle);
+					cosmic::infer_caches_for(typed_handle);
+					construct_post_inference(typed_handle);
+
+					::setup_entity_from_node_post_construct(
+						typed_node,
+						resource,
+						typed_handle
+					);
+				}, get_scene_flavour_id(typed_node, resource));
+			}
+		});
+	}
+
+	if (in.target_clean_round_state) {
+		*in.target_clean_round_state = cosm.get_solvable().significant;
+	}
+
+	return true;
+}
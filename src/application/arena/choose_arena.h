@@ -1,13 +1,17 @@
 #pragma once
 #include "augs/log_direct.h"
+#include "augs/filesystem/file.h"
+#include "augs/misc/secure_hash.h"
 #include "application/arena/arena_paths.h"
 #include "application/setups/editor/project/editor_project_paths.h"
 #include "application/setups/editor/project/editor_project_readwrite.h"
 #include "application/arena/arena_playtesting_context.h"
 #include "application/arena/build_arena_from_editor_project.h"
+#include "application/arena/arena_binary_cache.h"
 #include "application/setups/editor/packaged_official_content_declaration.h"
 
 #include "application/setups/editor/project/editor_project.h"
+#include "application/setups/editor/resources/resource_traits.h"
 #include "application/network/network_common.h"
 
 #include "augs/misc/web_sdk_events.h"
@@ -107,8 +111,74 @@ inline void load_arena_from_string(
 struct server_choose_arena_result {
 	augs::secure_hash_type loaded_arena_hash = augs::secure_hash_type();
 	augs::path_type arena_folder_path;
+
+	/* Paths are relative to arena_folder_path. */
+	editor_project_readwrite::external_resource_database external_resources;
 };
 
+inline auto gather_external_resources_of(const editor_project& project) {
+	editor_project_readwrite::external_resource_database result;
+
+	project.resources.pools.for_each_container(
+		[&]<typename P>(const P& pool) {
+			using R = typename P::mapped_type;
+
+			if constexpr(is_pathed_resource_v<R>) {
+				for (auto& resource : pool) {
+					const auto& file = resource.external_file;
+					result.emplace_back(file.path_in_project, augs::to_secure_hash_byte_format(file.file_hash));
+				}
+			}
+		}
+	);
+
+	return result;
+}
+
+inline void load_arena_from_path_or_binary_cache(
+	const choose_arena_input in,
+	const augs::path_type& json_path,
+	server_choose_arena_result& result
+) {
+	const auto json_document = augs::file_to_string_crlf_to_lf(json_path);
+	result.loaded_arena_hash = augs::secure_hash(json_document);
+
+	/* 
+		The playtested project changes all the time, so it is not worth caching.
+		On the web, the cache would only eat into the browser storage quota.
+	*/
+
+#if PLATFORM_WEB
+	const bool use_cache = false;
+#else
+	const bool use_cache = !in.is_for_playtesting();
+#endif
+	const auto cache_path = ::get_arena_binary_cache_path(result.loaded_arena_hash);
+
+	if (use_cache) {
+		if (::read_arena_binary_cache(cache_path, in.override_game_mode, in.handle, in.clean_round_state, result.external_resources)) {
+			LOG("Loaded the arena from binary cache: %x", cache_path);
+			return;
+		}
+	}
+
+	editor_project loaded_project;
+
+	auto building_in = in;
+
+	if (building_in.keep_loaded_project == nullptr) {
+		building_in.keep_loaded_project = std::addressof(loaded_project);
+	}
+
+	::load_arena_from_string(building_in, json_path.parent_path(), json_document, in.entity_to_node);
+
+	result.external_resources = ::gather_external_resources_of(*building_in.keep_loaded_project);
+
+	if (use_cache) {
+		::write_arena_binary_cache(cache_path, in.override_game_mode, in.handle, result.external_resources);
+	}
+}
+
 inline server_choose_arena_result choose_arena_server(
 	choose_arena_input in
 ) {
@@ -121,7 +191,7 @@ inline server_choose_arena_result choose_arena_server(
 	if (const auto path = ::server_choose_arena_file_by(in.name); !path.empty()) {
 		LOG_NOFORMAT("Loading arena from: " + path.string());
 
-		::load_arena_from_path(in, path, std::addressof(result.loaded_arena_hash));
+		::load_arena_from_path_or_binary_cache(in, path, result);
 
 		result.arena_folder_path = path.parent_path();
 	}
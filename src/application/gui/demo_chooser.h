@@ -52,7 +52,12 @@ public:
 				all_paths.clear();
 
 				auto path_adder = [this](const auto& full_path) {
-					if (full_path.extension() != ".demc") {
+					/*
+						.demc files were written by clients that recompressed whole demos.
+						They are listed so that choosing one explains why it cannot be replayed.
+					*/
+
+					if (full_path.extension() != ".dem" && full_path.extension() != ".demc") {
 						return callback_result::CONTINUE;
 					}
 
@@ -66,8 +71,13 @@ public:
 						demo_file_meta file_meta;
 						augs::read_bytes(t, file_meta);
 
-						meta.server_name = file_meta.server_name;
-						meta.write_time = augs::date_time::from_utc_timestamp(file_meta.when_recorded).how_long_ago();
+						if (!file_meta.is_supported_format()) {
+							meta.server_name = "Unsupported format";
+						}
+						else {
+							meta.server_name = file_meta.server_name;
+							meta.write_time = augs::date_time::from_utc_timestamp(file_meta.when_recorded).how_long_ago();
+						}
 					}
 					catch (const std::ifstream::failure&) {
 
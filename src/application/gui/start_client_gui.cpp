@@ -143,7 +143,10 @@ bool start_client_gui_state::perform(
 					augs::read_bytes(t, demo_meta);
 					demo_size = readable_bytesize(augs::get_file_size(demo_path));
 
-					if (demo_meta.version == hypersomnia_version()) {
+					if (!demo_meta.is_supported_format()) {
+						demo_choice_result = D::UNSUPPORTED_FORMAT;
+					}
+					else if (demo_meta.version == hypersomnia_version()) {
 						demo_choice_result = D::OK;
 					}
 					else {
@@ -162,6 +165,9 @@ bool start_client_gui_state::perform(
 				case D::FILE_OPEN_ERROR:
 					text_color(typesafe_sprintf("Could not open:\n%x\n\nWrong path or the file might be corrupt.", demo_path), red);
 					break;
+				case D::UNSUPPORTED_FORMAT:
+					text_color(typesafe_sprintf("This demo was recorded by an older client in a format that can no longer be replayed."), red);
+					break;
 				case D::MIGHT_BE_INCOMPATIBLE:
 					text_color(typesafe_sprintf("Your client differs from the one used to record this demo.\nYou may try replaying, but all bets are off - the game might even crash."), orange);
 					break;
@@ -172,7 +178,7 @@ bool start_client_gui_state::perform(
 					break;
 			}
 
-			if (!demo_path.empty() && demo_choice_result != D::FILE_OPEN_ERROR) {
+			if (!demo_path.empty() && demo_choice_result != D::FILE_OPEN_ERROR && demo_choice_result != D::UNSUPPORTED_FORMAT) {
 				text("Server address:");
 				ImGui::SameLine();
 				text_color(demo_meta.server_address, cyan);
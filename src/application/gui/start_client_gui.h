@@ -21,6 +21,7 @@ enum class demo_choice_result_type {
 
 	OK,
 	FILE_OPEN_ERROR,
+	UNSUPPORTED_FORMAT,
 	MIGHT_BE_INCOMPATIBLE
 };
 
@@ -189,4 +189,88 @@ static_assert(augs::has_byte_readwrite_overloads_v<augs::memory_stream, augs::po
 #include "application/arena/build_arena_from_editor_project.hpp"
 
 #include "application/network/network_common.h"
-template void build_arena_from_editor_project<online_arena_handle<false>>(online_arena_handle<false> arena_handle, build_arena_input);
\ No newline at end of file
+template void build_arena_from_editor_project<online_arena_handle<false>>(online_arena_handle<false> arena_handle, build_arena_input);
+template bool rebuild_arena_nodes_in_place<online_arena_handle<false>>(online_arena_handle<false> arena_handle, build_arena_input, const std::vector<editor_node_id>&);
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/readwrite/to_bytes.h"
+#include "augs/misc/pool/pool_allocate.h"
+#include "application/arena/arena_handle.h"
+#include "application/arena/synced_dynamic_vars.h"
+
+TEST_CASE("ArenaBuilding InPlaceRefreshMatchesFullBuild") {
+	const auto official = std::make_unique<packaged_official_content>();
+
+	struct built_arena {
+		intercosm scene;
+		all_rulesets_variant ruleset;
+		all_modes_variant mode;
+		cosmos_solvable_significant clean_round_state;
+		synced_dynamic_vars dynamic_vars;
+		scene_entity_to_node_map entity_to_node;
+
+		auto get_handle() {
+			return online_arena_handle<false> { mode, scene, scene.world, ruleset, clean_round_state, dynamic_vars };
+		}
+	};
+
+	editor_project project;
+
+	const auto layer_id = project.layers.pool.allocate().key;
+	project.layers.order.push_back(layer_id);
+
+	auto add_sprite = [&](const vec2 pos) {
+		editor_sprite_node node;
+		node.resource_id = official->resource_map.static_decorations.begin()->second;
+		node.editable.pos = pos;
+		node.unique_name = "Sprite " + std::to_string(project.nodes.next_chronological_order);
+		node.chronological_order = project.nodes.next_chronological_order++;
+
+		const auto raw_id = project.nodes.get_pool_for<editor_sprite_node>().allocate(node).key;
+		const auto node_id = editor_typed_node_id<editor_sprite_node>::from_raw(raw_id);
+
+		project.find_layer(layer_id)->hierarchy.nodes.push_back(node_id.operator editor_node_id());
+		return node_id;
+	};
+
+	add_sprite(vec2(-200, 0));
+	const auto edited = add_sprite(vec2(0, 0));
+	add_sprite(vec2(200, 0));
+
+	const auto override_game_mode = game_mode_name_type("");
+
+	auto make_input = [&](built_arena& arena) {
+		return build_arena_input {
+			project,
+			override_game_mode,
+			augs::path_type(),
+			*official,
+			std::addressof(arena.entity_to_node),
+			std::addressof(arena.clean_round_state),
+			true,
+			true
+		};
+	};
+
+	auto refreshed = std::make_unique<built_arena>();
+	::build_arena_from_editor_project(refreshed->get_handle(), make_input(*refreshed));
+
+	{
+		auto& node = *project.nodes.get_pool_for<editor_sprite_node>().find(edited.raw);
+
+		node.editable.pos = vec2(37, -120);
+		node.editable.rotation = 45.f;
+		node.editable.flip_horizontally = true;
+		node.editable.color = rgba(255, 0, 0, 128);
+	}
+
+	REQUIRE(::rebuild_arena_nodes_in_place(refreshed->get_handle(), make_input(*refreshed), { edited.operator editor_node_id() }));
+
+	auto rebuilt = std::make_unique<built_arena>();
+	::build_arena_from_editor_project(rebuilt->get_handle(), make_input(*rebuilt));
+
+	REQUIRE(augs::to_bytes(refreshed->scene.world.get_solvable().significant) == augs::to_bytes(rebuilt->scene.world.get_solvable().significant));
+	REQUIRE(augs::to_bytes(refreshed->clean_round_state) == augs::to_bytes(rebuilt->clean_round_state));
+}
+#endif
@@ -1,8 +1,28 @@
 #pragma once
+#include <unordered_map>
 #include "game/stateless_systems/visibility_system.h"
+#include "augs/graphics/vertex.h"
+
+/*
+	Visibility of a static light, reused for as long as the request stays the same
+	and only the same static bodies occlude it.
+*/
+
+struct cached_light_visibility {
+	visibility_request request;
+	uint64_t static_occluders_signature = 0;
+
+	visibility_response response;
+	augs::vertex_triangle_buffer triangles;
+
+	bool computed = false;
+	bool requested_this_frame = false;
+};
 
 struct cached_visibility_data {
 	visibility_response fow_response;
 	std::vector<visibility_response> light_responses;
 	std::vector<visibility_request> light_requests;
+
+	std::unordered_map<entity_id, cached_light_visibility> static_lights;
 };
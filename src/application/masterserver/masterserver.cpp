@@ -1,7 +1,7 @@
 #if PLATFORM_UNIX
 #include <csignal>
 #endif
-#include <shared_mutex>
+#include <deque>
 #include "application/masterserver/masterserver.h"
 #include "3rdparty/include_httplib.h"
 #include "augs/log.h"
@@ -24,7 +24,8 @@
 #include "application/detail_file_paths.h"
 #include "application/setups/server/webhooks.h"
 #include "application/masterserver/server_list_entry_json.h"
-#include "3rdparty/rapidjson/include/rapidjson/prettywriter.h"
+#include "application/masterserver/server_list_snapshot.h"
+#include "3rdparty/rapidjson/include/rapidjson/writer.h"
 #include "augs/readwrite/json_readwrite.h"
 #include "augs/network/netcode_utils.h"
 #include "augs/misc/httplib_utils.h"
@@ -66,9 +67,135 @@ void MSR_LOG(Args&&... args) {
 static void set_cors(httplib::Response& res) {
 	res.set_header("Access-Control-Allow-Origin", "*"); // Allows any domain
 	res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS"); // Allowed methods
-	res.set_header("Access-Control-Allow-Headers", "Origin, X-Requested-With, Content-Type, Accept, Authorization");
+	res.set_header("Access-Control-Allow-Headers", "Origin, X-Requested-With, Content-Type, Accept, Authorization, If-None-Match");
+	res.set_header("Access-Control-Expose-Headers", "ETag");
 };
 
+/*
+	If-None-Match is "*" or a comma-separated list of entity tags.
+	The comparison is weak, so a W/ prefix on either side is ignored.
+	Commas may appear inside a quoted tag, so the list is split outside of quotes only.
+*/
+
+static bool if_none_match_contains(const std::string_view header, const std::string_view etag) {
+	auto strip = [](std::string_view tag) {
+		while (!tag.empty() && (tag.front() == ' ' || tag.front() == '\t')) {
+			tag.remove_prefix(1);
+		}
+
+		while (!tag.empty() && (tag.back() == ' ' || tag.back() == '\t')) {
+			tag.remove_suffix(1);
+		}
+
+		if (tag.substr(0, 2) == "W/") {
+			tag.remove_prefix(2);
+		}
+
+		return tag;
+	};
+
+	const auto wanted = strip(etag);
+
+	bool in_quotes = false;
+	std::size_t tag_begin = 0;
+
+	for (std::size_t i = 0; i <= header.size(); ++i) {
+		if (i < header.size()) {
+			if (header[i] == '"') {
+				in_quotes = !in_quotes;
+			}
+
+			if (header[i] != ',' || in_quotes) {
+				continue;
+			}
+		}
+
+		const auto tag = strip(header.substr(tag_begin, i - tag_begin));
+
+		if (tag == "*" || (!tag.empty() && tag == wanted)) {
+			return true;
+		}
+
+		tag_begin = i + 1;
+	}
+
+	return false;
+}
+
+static bool matches_etag(const httplib::Request& req, httplib::Response& res, const std::string& etag) {
+	res.set_header("ETag", etag);
+
+	if (!req.has_header("If-None-Match")) {
+		return false;
+	}
+
+	return if_none_match_contains(req.get_header_value("If-None-Match"), etag);
+}
+
+static std::string make_server_list_delta_json(
+	const server_list_snapshot* const since,
+	const server_list_snapshot& current
+) {
+	/*
+		Without a known previous version,
+		every entry is sent as updated and the client should drop whatever it had.
+	*/
+
+	std::unordered_map<std::string_view, std::string_view> previous_objects;
+	std::unordered_map<std::string_view, bool> current_keys;
+
+	if (since != nullptr) {
+		for (const auto& e : since->json_entries) {
+			previous_objects.emplace(e.key, e.object);
+		}
+	}
+
+	rapidjson::StringBuffer s;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+	writer.StartObject();
+
+	writer.Key("version");
+	writer.Uint64(current.version);
+
+	writer.Key("full");
+	writer.Bool(since == nullptr);
+
+	writer.Key("updated");
+	writer.StartArray();
+
+	for (const auto& e : current.json_entries) {
+		current_keys.emplace(e.key, true);
+
+		if (const auto previous = mapped_or_nullptr(previous_objects, std::string_view(e.key))) {
+			if (*previous == e.object) {
+				continue;
+			}
+		}
+
+		writer.RawValue(e.object.data(), e.object.size(), rapidjson::kObjectType);
+	}
+
+	writer.EndArray();
+
+	writer.Key("removed");
+	writer.StartArray();
+
+	if (since != nullptr) {
+		for (const auto& e : since->json_entries) {
+			if (current_keys.find(e.key) == current_keys.end()) {
+				writer.String(e.key.c_str(), static_cast<rapidjson::SizeType>(e.key.size()));
+			}
+		}
+	}
+
+	writer.EndArray();
+
+	writer.EndObject();
+
+	return s.GetString();
+}
+
 using ip_to_host = std::unordered_map<
 	std::string,
 	std::string
@@ -251,10 +378,31 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 
 	std::unordered_map<netcode_address_t, masterserver_client> server_list;
 
-	std::vector<std::byte> serialized_list;
-	std::string serialized_list_json = "[]";
+	/*
+		Only the main thread publishes new snapshots.
+		The mutex guards just the pointers, never the contents.
+	*/
+
+	const auto launch_id = static_cast<uint64_t>(augs::date_time::secs_since_epoch());
+
+	auto make_etag = [launch_id](const uint64_t version) {
+		return typesafe_sprintf("\"%x-%x\"", launch_id, version);
+	};
+
+	const std::size_t max_recent_lists = 32;
 
-	std::shared_mutex serialized_list_mutex;
+	server_list_snapshot_ptr current_list = [&]() {
+		auto empty = std::make_shared<server_list_snapshot>();
+
+		empty->json = "[]";
+		empty->binary_etag = make_etag(0);
+		empty->json_etag = make_etag(0);
+
+		return empty;
+	}();
+
+	std::deque<server_list_snapshot_ptr> recent_lists = { current_list };
+	std::mutex current_list_mutex;
 
 	std::unique_ptr<httplib::Server> http_ptr;
 	std::unique_ptr<httplib::Server> fallback_http_ptr;
@@ -287,11 +435,9 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 
 		const auto peer_map = signalling.get_new_peers_map();
 
-		std::lock_guard<std::shared_mutex> lock(serialized_list_mutex);
-
-		serialized_list.clear();
+		auto snapshot = std::make_shared<server_list_snapshot>();
 
-		auto ss = augs::ref_memory_stream(serialized_list);
+		auto ss = augs::ref_memory_stream(snapshot->binary);
 
 		for (auto& server : server_list) {
 			const auto address = server.first;
@@ -327,9 +473,6 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 		}
 
 		rapidjson::StringBuffer s;
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(s);
-
-		writer.StartArray();
 
 		auto write_json_entry = [&](
 			const server_heartbeat& data,
@@ -394,7 +537,12 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 				return next.ip;
 			}();
 
+			s.Clear();
+
+			rapidjson::Writer<rapidjson::StringBuffer> writer(s);
 			augs::write_json(writer, next);
+
+			snapshot->json_entries.push_back({ next.browser_connect_string, s.GetString() });
 		};
 
 		for (const auto& server : server_list) {
@@ -432,15 +580,49 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 			);
 		}
 
-		writer.EndArray();
+		{
+			auto& json = snapshot->json;
+
+			json = "[";
+
+			for (const auto& e : snapshot->json_entries) {
+				if (json.size() > 1) {
+					json += ",";
+				}
+
+				json += e.object;
+			}
+
+			json += "]";
+		}
+
+		const auto& previous = *current_list;
 
-		serialized_list_json = s.GetString();
+		const bool binary_changed = snapshot->binary != previous.binary;
+		const bool json_changed = snapshot->json != previous.json;
+
+		if (!binary_changed && !json_changed) {
+			return;
+		}
+
+		snapshot->version = previous.version + 1;
+		snapshot->binary_etag = binary_changed ? make_etag(snapshot->version) : previous.binary_etag;
+		snapshot->json_etag = json_changed ? make_etag(snapshot->version) : previous.json_etag;
+
+		std::lock_guard<std::mutex> lock(current_list_mutex);
+
+		current_list = std::move(snapshot);
+		recent_lists.push_back(current_list);
+
+		while (recent_lists.size() > max_recent_lists) {
+			recent_lists.pop_front();
+		}
 	};
 
 	auto dump_server_list_to_file = [&]() {
-		if (!serialized_list.empty()) {
+		if (const auto& binary = current_list->binary; !binary.empty()) {
 			LOG("Saving servers to %x", masterserver_dump_path);
-			augs::bytes_to_file(std::as_const(serialized_list), masterserver_dump_path);
+			augs::bytes_to_file(binary, masterserver_dump_path);
 		}
 		else {
 			LOG("The server list is empty: deleting the dump file.");
@@ -487,15 +669,32 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 
 	load_server_list_from_file();
 
-	auto make_list_streamer_lambda = [&]() {
-		return [data=serialized_list](uint64_t offset, uint64_t length, DataSink& sink) {
-			return sink.write(reinterpret_cast<const char*>(&data[offset]), length);
+	auto get_current_list = [&]() {
+		std::lock_guard<std::mutex> lock(current_list_mutex);
+		return current_list;
+	};
+
+	auto find_recent_list = [&](const uint64_t version) -> server_list_snapshot_ptr {
+		std::lock_guard<std::mutex> lock(current_list_mutex);
+
+		for (const auto& l : recent_lists) {
+			if (l->version == version) {
+				return l;
+			}
+		}
+
+		return nullptr;
+	};
+
+	auto make_list_streamer_lambda = [](server_list_snapshot_ptr list) {
+		return [list=std::move(list)](uint64_t offset, uint64_t length, DataSink& sink) {
+			return sink.write(reinterpret_cast<const char*>(&list->binary[offset]), length);
 		};
 	};
 
-	auto make_json_list_streamer_lambda = [&]() {
-		return [data=serialized_list_json](uint64_t offset, uint64_t length, DataSink& sink) {
-			return sink.write(reinterpret_cast<const char*>(&data[offset]), length);
+	auto make_json_list_streamer_lambda = [](server_list_snapshot_ptr list) {
+		return [list=std::move(list)](uint64_t offset, uint64_t length, DataSink& sink) {
+			return sink.write(list->json.data() + offset, length);
 		};
 	};
 
@@ -643,38 +842,71 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 	};
 
 	auto define_http_server = [&](auto& server) {
-		server.Get("/server_list_binary", [&](const Request&, Response& res) {
-			std::shared_lock<std::shared_mutex> lock(serialized_list_mutex);
+		server.Get("/server_list_binary", [&](const Request& req, Response& res) {
+			auto list = get_current_list();
 
 			set_cors(res);
 
-			if (serialized_list.size() > 0) {
-				// MSR_LOG("List request arrived. Sending list of size: %x", serialized_list.size());
+			if (matches_etag(req, res, list->binary_etag)) {
+				res.status = 304;
+				return;
+			}
+
+			if (list->binary.size() > 0) {
+				// MSR_LOG("List request arrived. Sending list of size: %x", list->binary.size());
+
+				const auto size = list->binary.size();
 
 				res.set_content_provider(
-					serialized_list.size(),
+					size,
 					"application/octet-stream",
-					make_list_streamer_lambda()
+					make_list_streamer_lambda(std::move(list))
 				);
 			}
 		});
 
-		server.Get("/server_list_json", [&](const Request&, Response& res) {
-			std::shared_lock<std::shared_mutex> lock(serialized_list_mutex);
+		server.Get("/server_list_json", [&](const Request& req, Response& res) {
+			auto list = get_current_list();
 
 			set_cors(res);
 
-			if (serialized_list_json.size() > 0) {
-				// MSR_LOG("JSON list request arrived. Sending list of size: %x", serialized_list_json.size());
+			if (matches_etag(req, res, list->json_etag)) {
+				res.status = 304;
+				return;
+			}
+
+			if (list->json.size() > 0) {
+				// MSR_LOG("JSON list request arrived. Sending list of size: %x", list->json.size());
+
+				const auto size = list->json.size();
 
 				res.set_content_provider(
-					serialized_list_json.size(),
+					size,
 					"application/json",
-					make_json_list_streamer_lambda()
+					make_json_list_streamer_lambda(std::move(list))
 				);
 			}
 		});
 
+		server.Get("/server_list_json_delta", [&](const Request& req, Response& res) {
+			const auto list = get_current_list();
+
+			set_cors(res);
+
+			server_list_snapshot_ptr since;
+
+			if (req.has_param("since")) {
+				try {
+					since = find_recent_list(std::stoull(req.get_param_value("since")));
+				}
+				catch (const std::exception&) {
+					/* A malformed version is answered with the full list. */
+				}
+			}
+
+			res.set_content(make_server_list_delta_json(since.get(), *list), "application/json");
+		});
+
 		server.Options("/server_list_binary", [](const httplib::Request&, httplib::Response& res) {
 			set_cors(res);
 			res.status = 204;
@@ -684,6 +916,11 @@ work_result perform_masterserver(const config_json_table& cfg) try {
 			set_cors(res);
 			res.status = 204;
 		});
+
+		server.Options("/server_list_json_delta", [](const httplib::Request&, httplib::Response& res) {
+			set_cors(res);
+			res.status = 204;
+		});
 	};
 
 	define_http_server(*http_ptr);
@@ -1023,3 +1260,24 @@ catch (const netcode_socket_raii_error& err) {
 	LOG(err.what());
 	return work_result::FAILURE;
 }
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("Masterserver IfNoneMatchComparesWholeTags") {
+	const std::string etag = "\"1700000000-12\"";
+
+	REQUIRE(if_none_match_contains("\"1700000000-12\"", etag));
+	REQUIRE(if_none_match_contains("*", etag));
+	REQUIRE(if_none_match_contains(" W/\"1700000000-12\" ", etag));
+	REQUIRE(if_none_match_contains("\"1700000000-11\", \"1700000000-12\"", etag));
+	REQUIRE(if_none_match_contains("\"a,b\",W/\"1700000000-12\"", etag));
+
+	/* A substring of another tag is not a match. */
+	REQUIRE(!if_none_match_contains("\"1700000000-123\"", etag));
+	REQUIRE(!if_none_match_contains("\"x\"1700000000-12\"\"", etag));
+	REQUIRE(!if_none_match_contains("1700000000-12", etag));
+	REQUIRE(!if_none_match_contains("", etag));
+	REQUIRE(!if_none_match_contains(" , ", etag));
+}
+#endif
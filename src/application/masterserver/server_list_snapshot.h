@@ -0,0 +1,34 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/*
+	An immutable version of the published server list.
+
+	HTTP handlers only copy the shared pointer under the lock,
+	so answering a poll never copies the list itself,
+	and a snapshot stays alive for as long as some response still streams it.
+*/
+
+struct server_list_snapshot {
+	struct json_entry {
+		std::string key;
+		std::string object;
+	};
+
+	uint64_t version = 0;
+
+	std::string binary_etag;
+	std::string json_etag;
+
+	std::vector<std::byte> binary;
+
+	/* Compact JSON array of all json_entries, in the same order. */
+	std::string json;
+	std::vector<json_entry> json_entries;
+};
+
+using server_list_snapshot_ptr = std::shared_ptr<const server_list_snapshot>;
@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <optional>
+
+/*
+	The serialized and compressed body of the full arena snapshot,
+	i.e. the solvable and the mode state without the per-recipient header.
+
+	After a map change or a round restart many clients ask for the snapshot within the same few ticks,
+	so the body is built once per server step and sent to all of them.
+*/
+
+struct arena_snapshot_cache {
+	/* The uncompressed size followed by the LZ4-compressed stream, as written by compress_arena_snapshot_body. */
+	std::vector<std::byte> compressed_body;
+	std::optional<unsigned> step;
+
+	bool is_valid_for(const unsigned current_step) const {
+		return step == current_step;
+	}
+
+	void invalidate() {
+		step.reset();
+	}
+};
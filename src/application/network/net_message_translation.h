@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include "augs/readwrite/memory_stream.h"
 #include "augs/misc/serialization_buffers.h"
 #include "augs/misc/compress.h"
@@ -8,6 +9,11 @@
 #include "application/network/net_solvable_stream.h"
 #include "augs/string/get_type_name.h"
 
+/*
+	Only the reading side uses the full payload.
+	The writing side sends a body shared between recipients, see arena_snapshot_cache.
+*/
+
 template <bool C>
 struct full_arena_snapshot_payload {
 	maybe_const_ref_t<C, cosmos_solvable_significant> signi;
@@ -79,6 +85,74 @@ constexpr std::size_t max_server_step_size_v =
 	- yojimbo::ConservativeMessageHeaderBits / 8
 ;
 
+inline bool preserialize_shared_step_entropy(
+	networked_server_step_entropy& input,
+	preserialized_step_entropy_body& output
+) {
+	auto& words = output.words;
+	words.resize(max_packet_size_v / sizeof(uint32_t));
+
+	auto stream = yojimbo::WriteStream(
+		reinterpret_cast<uint8_t*>(words.data()), 
+		static_cast<int>(words.size() * sizeof(uint32_t))
+	);
+
+	if (!net_messages::serialize_shared_step_entropy(stream, input.meta, input.payload)) {
+		return false;
+	}
+
+	stream.Flush();
+
+	output.num_bits = stream.GetBitsProcessed();
+	words.resize((output.num_bits + 31) / 32);
+
+	return true;
+}
+
+/*
+	Only the solvable and the mode state go here.
+	The recipient-specific client id and rcon level are prepended by full_arena_snapshot::write_payload,
+	so that the result can be shared by everyone who joins during the same step.
+*/
+
+inline void compress_arena_snapshot_body(
+	augs::serialization_buffers& buffers,
+	const cosmos_solvable_significant& clean_round_state,
+	const all_entity_flavours& all_flavours,
+	const cosmos_solvable_significant& signi,
+	const all_modes_variant& mode,
+	std::vector<std::byte>& output
+) {
+	{
+		NSR_LOG("STAGE: SERIALIZATION");
+
+		auto s = buffers.make_serialization_stream<net_solvable_stream_ref>(all_flavours, clean_round_state, signi);
+
+		augs::write_bytes(s, signi);
+		augs::write_bytes(s, mode);
+
+		NSR_LOG("Result stream length: %x", buffers.serialization.size());
+	}
+
+	{
+		NSR_LOG("STAGE: COMPRESSION");
+
+		output.clear();
+
+		{
+			auto s = augs::ref_memory_stream(output);
+			const auto uncompressed_size = static_cast<uint32_t>(buffers.serialization.size());
+			augs::write_bytes(s, uncompressed_size);
+
+			LOG("Uncompressed arena snapshot size: %x", uncompressed_size);
+		}
+
+		augs::compress(buffers.compression_state, buffers.serialization, output);
+
+		LOG("Compressed arena snapshot size: %x", output.size());
+	}
+}
+
 namespace net_messages {
 	inline bool new_server_vars::read_payload(
 		server_vars& output
@@ -236,14 +310,24 @@ namespace net_messages {
 
 		LOG("Compressed arena snapshot size: %x", size);
 
-		const bool size_written_properly = size >= sizeof(uint32_t);
+		uint32_t uncompressed_size = 0;
+		std::size_t header_size = 0;
+
+		try {
+			auto header = augs::make_ptr_read_stream(data, size);
 
-		if (!size_written_properly) {
+			augs::read_bytes(header, in.client_id);
+			augs::read_bytes(header, in.rcon);
+			augs::read_bytes(header, uncompressed_size);
+
+			header_size = header.get_read_pos();
+		}
+		catch (const augs::stream_read_error& err) {
+			LOG("Failed to read the arena snapshot header: %x", err.what());
 			return false;
 		}
 
-		const auto uncompressed_size = *reinterpret_cast<const uint32_t*>(data);
-	
+		NSR_LOG_NVPS(in.client_id);
 		LOG("Uncompressed arena snapshot size: %x", uncompressed_size);
 
 		/*
@@ -259,8 +343,8 @@ namespace net_messages {
 
 		try {
 			augs::decompress(
-				data + sizeof(uint32_t),
-				size - sizeof(uint32_t),
+				data + header_size,
+				size - header_size,
 				uncompressed_buf
 			);
 
@@ -277,10 +361,6 @@ namespace net_messages {
 
 		augs::read_bytes(s, in.signi);
 		augs::read_bytes(s, in.mode);
-		augs::read_bytes(s, in.client_id);
-		augs::read_bytes(s, in.rcon);
-
-		NSR_LOG_NVPS(in.client_id);
 
 		return true;
 	}
@@ -288,59 +368,23 @@ namespace net_messages {
 	template <class F>
 	inline bool full_arena_snapshot::write_payload(
 		F block_allocator,
-		augs::serialization_buffers& buffers,
-		const cosmos_solvable_significant& clean_round_state,
-		const all_entity_flavours& all_flavours,
-		const full_arena_snapshot_payload<true> in
+		const arena_snapshot_cache& body,
+		const uint32_t client_id,
+		const rcon_level_type rcon
 	) {
-		auto write_all_to = [&in](auto& s) {
-			augs::write_bytes(s, in.signi);
-			augs::write_bytes(s, in.mode);
-			augs::write_bytes(s, in.client_id);
-			augs::write_bytes(s, in.rcon);
-		};
-
 		NSR_LOG("SENDING INITIAL STATE");
 
-		{
-			NSR_LOG("STAGE: ESTIMATION");
-
-			augs::byte_counter_stream s;
-			write_all_to(s);
-			buffers.serialization.reserve(s.size());
+		std::array<std::byte, sizeof(client_id) + sizeof(rcon)> header;
+		auto s = augs::make_ptr_write_stream(header.data(), header.size());
 
-			NSR_LOG("Reserved size: %x", s.size());
+		augs::write_bytes(s, client_id);
+		augs::write_bytes(s, rcon);
 
-			{
-				auto s = buffers.make_serialization_stream<net_solvable_stream_ref>(all_flavours, clean_round_state, in.signi);
-				write_all_to(s);
-			}
-
-			NSR_LOG("Result stream length: %x", buffers.serialization.size());
-		}
-
-		auto& c = buffers.compressed;
-
-		{
-			NSR_LOG("STAGE: COMPRESSION");
-
-			c.clear();
-
-			{
-				auto s = augs::ref_memory_stream(c);
-				const auto uncompressed_size = static_cast<uint32_t>(buffers.serialization.size());
-				augs::write_bytes(s, uncompressed_size);
-
-				LOG("Uncompressed arena snapshot size: %x", uncompressed_size);
-			}
-
-			augs::compress(buffers.compression_state, buffers.serialization, c);
-
-			LOG("Compressed arena snapshot size: %x", c.size());
-		}
+		const auto& c = body.compressed_body;
 
-		auto block = block_allocator(c.size());
-		std::memcpy(block, c.data(), c.size());
+		auto block = block_allocator(header.size() + c.size());
+		std::memcpy(block, header.data(), header.size());
+		std::memcpy(block + header.size(), c.data(), c.size());
 
 		return true;
 	}
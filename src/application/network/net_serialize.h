@@ -569,15 +569,14 @@ namespace net_messages {
 	}
 
 	template <class Stream>
-	bool serialize(Stream& s, ::networked_server_step_entropy& total_networked) {
-		auto& i = total_networked.payload;
+	bool serialize_shared_step_entropy(
+		Stream& s, 
+		::server_step_entropy_meta& meta,
+		::compact_server_step_entropy& i
+	) {
 		auto& g = i.general;
 
-		if (!serialize(s, total_networked.context)) {
-			return false;
-		}
-
-		auto& state_hash = total_networked.meta.state_hash;
+		auto& state_hash = meta.state_hash;
 		bool has_state_hash = logically_set(state_hash);
 
 		bool has_players = logically_set(i.players);
@@ -591,7 +590,7 @@ namespace net_messages {
 		serialize_bool(s, has_removed_player);
 		serialize_bool(s, has_special_command);
 
-		serialize_bool(s, total_networked.meta.reinference_necessary);
+		serialize_bool(s, meta.reinference_necessary);
 
 		serialize_align(s);
 
@@ -647,4 +646,30 @@ namespace net_messages {
 
 		return true;
 	}
+
+	/*
+		The shared part may be preserialized once at bit offset 0 and spliced after the context of every message.
+		Its serialize_align calls only hold if the splice starts at a byte boundary too,
+		hence the context is padded to one regardless of where the message begins within the packet.
+	*/
+
+	template <class Stream>
+	bool serialize_step_entropy_context(Stream& s, ::prestep_client_context& context) {
+		if (!serialize(s, context)) {
+			return false;
+		}
+
+		serialize_align(s);
+
+		return true;
+	}
+
+	template <class Stream>
+	bool serialize(Stream& s, ::networked_server_step_entropy& total_networked) {
+		if (!serialize_step_entropy_context(s, total_networked.context)) {
+			return false;
+		}
+
+		return serialize_shared_step_entropy(s, total_networked.meta, total_networked.payload);
+	}
 }
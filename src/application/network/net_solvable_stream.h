@@ -1,15 +1,18 @@
 #pragma once
-
-template <class V>
-constexpr bool never_changes_in_game = is_one_of_v<V,
-	make_entity_pool<static_decoration>,
-	make_entity_pool<area_marker>,
-	make_entity_pool<particles_decoration>,
-	make_entity_pool<wandering_pixels_decoration>,
-	make_entity_pool<point_marker>,
-	make_entity_pool<static_light>,
-	make_entity_pool<area_sensor>
->;
+#include "augs/readwrite/delta_compression.h"
+#include "game/cosmos/never_changes_in_game.h"
+
+/*
+	How an entity of a partially synchronized pool is written in an arena snapshot.
+	Most entities diverge only in a handful of bytes from the clean round state,
+	so late in a round it's usually much cheaper to send a delta than the whole entity.
+*/
+
+enum class net_entity_encoding : uint8_t {
+	UNCHANGED,
+	WHOLE,
+	DELTA_FROM_INITIAL
+};
 
 using physics_bodies = make_entity_pool<plain_sprited_body>;
 using physics_bodies_vector = typename physics_bodies::object_pool_type;
@@ -53,43 +56,54 @@ struct net_solvable_stream_ref : augs::ref_memory_stream {
 		augs::write_bytes(*this, static_cast<uint32_t>(storage.size()));
 
 		for (const auto& s : storage) {
+			using S = remove_cref<decltype(s)>;
+			static_assert(std::is_trivially_copyable_v<S>);
+
 			const bool never_changes_at_all = never_changes_pred(body_flavours[s.flavour_id]);
 			const auto this_idx = index_in(storage, s);
 			const auto this_id = current_pool.find_nth_id(this_idx);
 
-			const auto has_changed_byte = [&]() -> uint8_t {
-				if (never_changes_at_all) {
-					return 0;
-				}
+			if (never_changes_at_all) {
+				augs::write_bytes(*this, net_entity_encoding::UNCHANGED);
+				augs::write_bytes(*this, this_id.to_unversioned());
 
-				static_assert(std::is_trivially_copyable_v<remove_cref<decltype(s)>>);
+				continue;
+			}
 
-				if (const auto correspondent_initial = initial_pool.find(this_id)) {
-					if (!std::memcmp(std::addressof(s), correspondent_initial, sizeof(*correspondent_initial))) {
-						return 0;
-					}
-				}
+			const auto correspondent_initial = initial_pool.find(this_id);
 
-				return 1;
-			}();
-			 
-			augs::write_bytes(*this, has_changed_byte);
-			
-			if (has_changed_byte != 0) {
+			if (correspondent_initial == nullptr) {
+				augs::write_bytes(*this, net_entity_encoding::WHOLE);
 				augs::write_bytes(*this, s);
+
+				continue;
 			}
-			else {
+
+			if (!std::memcmp(std::addressof(s), correspondent_initial, sizeof(*correspondent_initial))) {
+				augs::write_bytes(*this, net_entity_encoding::UNCHANGED);
+				augs::write_bytes(*this, this_id.to_unversioned());
+
+				continue;
+			}
+
+			const auto delta = augs::object_delta<S>(*correspondent_initial, s);
+
+			if (delta.get_written_size() + sizeof(this_id.to_unversioned()) < sizeof(S)) {
+				augs::write_bytes(*this, net_entity_encoding::DELTA_FROM_INITIAL);
 				augs::write_bytes(*this, this_id.to_unversioned());
+
+				delta.write(*this);
+			}
+			else {
+				augs::write_bytes(*this, net_entity_encoding::WHOLE);
+				augs::write_bytes(*this, s);
 			}
 		}
 	}
 
 	void special_write(const physics_bodies_vector& storage) {
 		auto never_changes_pred = [&](const auto& flav) {
-			return 
-				flav.template get<invariants::rigid_body>().body_type == rigid_body_type::ALWAYS_STATIC
-				&& !flav.template get<invariants::animation>().id.is_set() /* Otherwise need to properly serialize animation state */
-			;
+			return flavour_never_changes_in_game(flav);
 		};
 
 		special_write_if_changed(storage, never_changes_pred);
@@ -97,7 +111,7 @@ struct net_solvable_stream_ref : augs::ref_memory_stream {
 
 	void special_write(const dynamic_decorations_vector& storage) {
 		auto never_changes_pred = [&](const auto& flav) {
-			return flav.template get<invariants::animation>().is_irrelevant_to_logic;
+			return flavour_never_changes_in_game(flav);
 		};
 
 		special_write_if_changed(storage, never_changes_pred);
@@ -137,18 +151,40 @@ struct net_solvable_stream_cref : augs::cref_memory_stream {
 
 		using unversioned_id_type = typename remove_cref<decltype(initial_bodies)>::unversioned_id_type;
 
+		using S = typename V::value_type;
+
 		for (size_type i = 0; i < n; ++i) {
-			uint8_t has_changed_byte;
-			augs::read_bytes(*this, has_changed_byte);
+			net_entity_encoding encoding;
+			augs::read_bytes(*this, encoding);
 
-			if (has_changed_byte != 0) {
+			if (encoding == net_entity_encoding::WHOLE) {
 				augs::read_bytes(*this, storage[i]);
+				continue;
 			}
-			else {
-				unversioned_id_type id;
-				augs::read_bytes(*this, id);
 
-				storage[i] = initial_bodies[initial_bodies.get_versioned(id)];
+			if (encoding != net_entity_encoding::UNCHANGED && encoding != net_entity_encoding::DELTA_FROM_INITIAL) {
+				throw augs::stream_read_error("Unknown entity encoding: %x", static_cast<int>(encoding));
+			}
+
+			unversioned_id_type id;
+			augs::read_bytes(*this, id);
+
+			const auto initial = initial_bodies.find(initial_bodies.find_versioned(id));
+
+			if (initial == nullptr) {
+				throw augs::stream_read_error("Entity encoded relative to a nonexistent initial entity.");
+			}
+
+			storage[i] = *initial;
+
+			if (encoding == net_entity_encoding::DELTA_FROM_INITIAL) {
+				const auto delta = augs::object_delta<S>(*this);
+
+				if (!delta.fits_in_object()) {
+					throw augs::stream_read_error("Entity delta exceeds the entity size.");
+				}
+
+				delta.decode_into(storage[i]);
 			}
 		}
 	}
@@ -849,3 +849,157 @@ const netcode_socket_t* server_adapter::find_underlying_socket() const {
 
 	return nullptr;
 }
+
+#if BUILD_UNIT_TESTS
+#include <algorithm>
+#include <cstring>
+#include <Catch/single_include/catch2/catch.hpp>
+#include "application/network/net_message_translation.h"
+
+TEST_CASE("NetSerialization PreserializedEntropyAtUnalignedOffsets") {
+	networked_server_step_entropy sent;
+	sent.context.num_entropies_accepted = 3;
+	sent.meta.state_hash = 0xdeadbeef;
+	sent.meta.reinference_necessary = true;
+
+	{
+		total_mode_player_entropy t;
+		t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { 1, -1 };
+		t.cosmic.intents.push_back({ game_intent_type::INTERACT, intent_change::PRESSED });
+
+		sent.payload.players.push_back({ mode_player_id::first(), t });
+		sent.payload.players.push_back({ mode_player_id::machine_admin(), {} });
+	}
+
+	auto body = std::make_shared<preserialized_step_entropy_body>();
+
+	{
+		auto shared = sent;
+		REQUIRE(preserialize_shared_step_entropy(shared, *body));
+	}
+
+	/* Stands for whatever yojimbo writes before the message within the packet. */
+	auto serialize_header_bits = [](auto& stream, const int num_bits) {
+		for (int i = 0; i < num_bits; ++i) {
+			uint32_t bit = i % 3 == 0;
+
+			if (!stream.SerializeBits(bit, 1)) {
+				return false;
+			}
+
+			if (bit != uint32_t(i % 3 == 0)) {
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	auto write_at = [&](const int offset, const bool preserialized) {
+		std::vector<uint32_t> words;
+		words.resize(max_packet_size_v / sizeof(uint32_t));
+
+		auto stream = yojimbo::WriteStream(reinterpret_cast<uint8_t*>(words.data()), static_cast<int>(words.size() * sizeof(uint32_t)));
+
+		net_messages::server_step_entropy msg;
+		msg.Release();
+
+		if (preserialized) {
+			REQUIRE(msg.write_payload(sent.context, body));
+		}
+		else {
+			REQUIRE(msg.write_payload(sent));
+		}
+
+		REQUIRE(serialize_header_bits(stream, offset));
+		REQUIRE(msg.Serialize(stream));
+		stream.Flush();
+
+		words.resize((stream.GetBitsProcessed() + 31) / 32);
+		return words;
+	};
+
+	for (const int offset : { 0, 1, 3, 7, 8, 13, 31, 32, 45 }) {
+		const auto spliced = write_at(offset, true);
+		REQUIRE(spliced == write_at(offset, false));
+
+		auto stream = yojimbo::ReadStream(reinterpret_cast<const uint8_t*>(spliced.data()), static_cast<int>(spliced.size() * sizeof(uint32_t)));
+
+		net_messages::server_step_entropy msg;
+		msg.Release();
+
+		REQUIRE(serialize_header_bits(stream, offset));
+		REQUIRE(msg.Serialize(stream));
+
+		networked_server_step_entropy received;
+		REQUIRE(msg.read_payload(received));
+		REQUIRE(received == sent);
+	}
+}
+
+TEST_CASE("NetSerialization SharedArenaSnapshotBody") {
+	cosmos_solvable_significant clean_round_state;
+	all_entity_flavours flavours;
+
+	cosmos_solvable_significant signi;
+	signi.clk.now.step = 1234;
+
+	all_modes_variant mode;
+
+	augs::serialization_buffers buffers;
+	arena_snapshot_cache body;
+
+	compress_arena_snapshot_body(buffers, clean_round_state, flavours, signi, mode, body.compressed_body);
+
+	auto write_for = [&](const uint32_t client_id, const rcon_level_type rcon) {
+		std::vector<uint8_t> block;
+
+		net_messages::full_arena_snapshot msg;
+		msg.Release();
+
+		auto block_allocator = [&block](const std::size_t n) {
+			block.resize(n);
+			return block.data();
+		};
+
+		REQUIRE(msg.write_payload(block_allocator, body, client_id, rcon));
+		return block;
+	};
+
+	const auto header_size = sizeof(uint32_t) + sizeof(rcon_level_type);
+
+	/* Two recipients during the same step. */
+	const auto first = write_for(3, rcon_level_type::BASIC);
+	const auto second = write_for(7, rcon_level_type::MASTER);
+
+	REQUIRE(first.size() == header_size + body.compressed_body.size());
+	REQUIRE(second.size() == first.size());
+	REQUIRE(std::equal(first.begin() + header_size, first.end(), second.begin() + header_size));
+	REQUIRE(!std::equal(first.begin(), first.begin() + header_size, second.begin()));
+
+	auto read_back = [&](const std::vector<uint8_t>& block, const uint32_t expected_client_id, const rcon_level_type expected_rcon) {
+		auto& allocator = yojimbo::GetDefaultAllocator();
+
+		const auto block_bytes = reinterpret_cast<uint8_t*>(YOJIMBO_ALLOCATE(allocator, block.size()));
+		std::memcpy(block_bytes, block.data(), block.size());
+
+		net_messages::full_arena_snapshot msg;
+		msg.Release();
+		msg.AttachBlock(allocator, block_bytes, static_cast<int>(block.size()));
+
+		cosmos_solvable_significant read_signi;
+		all_modes_variant read_mode;
+		uint32_t read_client_id = 0;
+		auto read_rcon = rcon_level_type::DENIED;
+
+		REQUIRE(msg.read_payload(buffers, clean_round_state, { read_signi, read_mode, read_client_id, read_rcon }));
+
+		REQUIRE(read_client_id == expected_client_id);
+		REQUIRE(read_rcon == expected_rcon);
+		REQUIRE(read_signi.clk.now.step == signi.clk.now.step);
+	};
+
+	read_back(first, 3, rcon_level_type::BASIC);
+	read_back(second, 7, rcon_level_type::MASTER);
+}
+#endif
@@ -1,14 +1,17 @@
 #pragma once
+#include <memory>
 #include "3rdparty/yojimbo/include/yojimbo.h"
 #undef write_bytes
 #undef read_bytes
 
+#include "augs/ensure.h"
 #include "augs/misc/constant_size_vector.h"
 #include "game/modes/mode_entropy.h"
 #include "augs/misc/serialization_buffers.h"
 #include "application/network/server_step_entropy.h"
 #include "application/network/special_client_request.h"
 #include "application/network/rcon_command.h"
+#include "application/setups/server/rcon_level.h"
 #include "application/setups/server/chat_structs.h"
 #include "application/setups/server/net_statistics_update.h"
 #include "application/setups/server/server_vars.h"
@@ -20,6 +23,7 @@
 #include "application/network/net_serialize.h"
 #include "application/network/download_progress_message.h"
 #include "application/arena/synced_dynamic_vars.h"
+#include "application/network/arena_snapshot_cache.h"
 
 #define LOG_NET_SERIALIZATION !IS_PRODUCTION_BUILD
 
@@ -155,6 +159,39 @@ struct only_block_message : public yojimbo::BlockMessage {
 template <bool C>
 struct full_arena_snapshot_payload;
 
+struct preserialized_step_entropy_body {
+	/* 
+		Raw words as produced by yojimbo::WriteStream,
+		so that they can be re-emitted bit-for-bit at any offset of another stream.
+	*/
+
+	std::vector<uint32_t> words;
+	int num_bits = 0;
+
+	template <class Stream>
+	bool write_to(Stream& stream) const {
+		if constexpr(std::is_same_v<Stream, yojimbo::WriteStream>) {
+			/* See serialize_step_entropy_context. */
+			ensure_eq(0, stream.GetBitsProcessed() % 8);
+		}
+
+		const auto num_full_words = num_bits / 32;
+		const auto num_remaining_bits = num_bits % 32;
+
+		for (int i = 0; i < num_full_words; ++i) {
+			auto word = words[i];
+			serialize_bits(stream, word, 32);
+		}
+
+		if (num_remaining_bits > 0) {
+			auto word = words[num_full_words] & ((uint32_t(1) << num_remaining_bits) - 1);
+			serialize_bits(stream, word, num_remaining_bits);
+		}
+
+		return true;
+	}
+};
+
 namespace net_messages {
 	struct client_welcome : net_message_with_payload<requested_client_settings> {
 		static constexpr bool server_to_client = false;
@@ -173,9 +210,62 @@ namespace net_messages {
 
 	//struct initial_steps_correction : only_block_message {};
 
-	struct server_step_entropy : net_message_with_payload<networked_server_step_entropy> {
+	struct server_step_entropy : yojimbo::Message {
 		static constexpr bool server_to_client = true;
 		static constexpr bool client_to_server = false;
+
+		networked_server_step_entropy payload;
+
+		/*
+			Everything except the context is identical for all recipients,
+			so when multicasting, the server serializes it only once
+			and each per-client message just copies the same bits after its own context.
+		*/
+
+		std::shared_ptr<const preserialized_step_entropy_body> preserialized_body;
+
+		template <typename Stream>
+		bool Serialize(Stream& stream) {
+			if constexpr(Stream::IsWriting) {
+				if (preserialized_body != nullptr) {
+					if (!net_messages::serialize_step_entropy_context(stream, payload.context)) {
+						return false;
+					}
+
+					return preserialized_body->write_to(stream);
+				}
+			}
+
+			return net_messages::serialize(stream, payload);
+		}
+
+		inline bool read_payload(
+			networked_server_step_entropy& output
+		) {
+			output = std::move(payload);
+			return true;
+		}
+
+		inline bool write_payload(
+			const networked_server_step_entropy& input
+		) {
+			payload = input;
+			preserialized_body = nullptr;
+
+			return true;
+		}
+
+		inline bool write_payload(
+			const prestep_client_context& context,
+			const std::shared_ptr<const preserialized_step_entropy_body>& body
+		) {
+			payload.context = context;
+			preserialized_body = body;
+
+			return body != nullptr;
+		}
+
+		YOJIMBO_MESSAGE_BOILERPLATE();
 	};
 
 	struct client_entropy : net_message_with_payload<total_client_entropy> {
@@ -250,10 +340,9 @@ namespace net_messages {
 		template <class F>
 		bool write_payload(
 			F block_allocator,
-			augs::serialization_buffers&,
-			const cosmos_solvable_significant& clean_round_state,
-			const all_entity_flavours& all_flavours,
-			full_arena_snapshot_payload<true>
+			const arena_snapshot_cache& body,
+			uint32_t client_id,
+			rcon_level_type rcon
 		);
 	};
 
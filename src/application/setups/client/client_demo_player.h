@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
+#include <optional>
+#include <string>
 #include "application/gui/client/demo_player_gui.h"
+#include "application/setups/client/demo_step_reader.h"
 #include "augs/misc/timing/fixed_delta_timer.h"
 
 struct client_demo_player {
@@ -12,7 +16,7 @@ struct client_demo_player {
 	demo_step default_step;
 
 	std::optional<demo_step_num_type> requested_seek;
-	std::vector<demo_step> demo_steps;
+	demo_step_reader demo_steps;
 	demo_step_num_type current_step = 0;
 
 	double speed = 1.0;
@@ -70,12 +74,17 @@ struct client_demo_player {
 
 	template <class StepState>
 	void advance_player(StepState advance_state) {
-		if (current_step < demo_steps.size()) {
-			current_secs += advance_state(demo_steps[current_step]);
+		if (const auto step = demo_steps.find(current_step)) {
+			current_secs += advance_state(*step);
 
 			++current_step;
 		}
 		else {
+			if (current_step < demo_steps.size()) {
+				replay_failed_reason = "Failed to read the demo at step " + std::to_string(current_step) + ".";
+				pause();
+			}
+
 			current_secs += advance_state(default_step);
 		}
 	}
@@ -87,23 +96,75 @@ struct client_demo_player {
 		current_secs = 0;
 	}
 
-	template <class StepState, class SeekingStepState, class RewindState>
+	std::optional<demo_step_num_type> find_keyframe_before(const demo_step_num_type n) const {
+		const auto& keyframes = demo_steps.get_keyframes();
+		const auto it = std::upper_bound(keyframes.begin(), keyframes.end(), n);
+
+		if (it == keyframes.begin()) {
+			return std::nullopt;
+		}
+
+		return *std::prev(it);
+	}
+
+	template <class RewindState, class RestoreKeyframe>
+	void seek_player(
+		const demo_step_num_type target_step,
+		RewindState rewind_state,
+		RestoreKeyframe restore_keyframe,
+		const double inv_tickrate
+	) {
+		/*
+			Restoring a keyframe pays off whenever it lies past the current step,
+			which is always the case when seeking backward.
+		*/
+
+		if (const auto keyframe_step = find_keyframe_before(target_step)) {
+			const bool worth_it = *keyframe_step > current_step || target_step < current_step;
+
+			const auto keyframe = worth_it ? demo_steps.find(*keyframe_step) : nullptr;
+
+			if (keyframe != nullptr) {
+				if (restore_keyframe(keyframe->keyframe)) {
+					current_step = *keyframe_step;
+					current_secs = current_step * inv_tickrate;
+
+					return;
+				}
+
+				/* Corrupt keyframe. Fall back to the full replay. */
+				rewind_player(rewind_state);
+				return;
+			}
+		}
+
+		if (target_step < current_step) {
+			rewind_player(rewind_state);
+		}
+	}
+
+	template <class StepState, class SeekingStepState, class RewindState, class RestoreKeyframe>
 	void advance(
 		augs::delta frame_delta,
 		StepState step_state, 
 		SeekingStepState seeking_step_state, 
 		RewindState rewind_state,
+		RestoreKeyframe restore_keyframe,
 		const double inv_tickrate
 	) {
 		if (requested_seek.has_value()) {
-			const auto target_step = *requested_seek;
+			const auto target_step = std::min(*requested_seek, demo_steps.size());
 
-			if (target_step < current_step) {
-				rewind_player(rewind_state);
-			}
+			seek_player(target_step, rewind_state, restore_keyframe, inv_tickrate);
 
 			while (current_step < target_step) {
+				const auto previous_step = current_step;
+
 				advance_player(seeking_step_state);
+
+				if (current_step == previous_step) {
+					break;
+				}
 			}
 
 			requested_seek = std::nullopt;
@@ -390,38 +390,13 @@ struct webrtc_client_detail {
 
 void client_demo_player::play_demo_from(const augs::path_type& p) {
 	source_path = p;
+	meta = demo_steps.open(source_path);
 
-	auto source_bytes = augs::file_to_bytes(source_path);
-	auto source = augs::make_ptr_read_stream(source_bytes);
-	augs::read_bytes(source, meta);
-
-	const auto pos = source.get_read_pos();
-
-	if (pos < source_bytes.size()) {
-		std::vector<std::byte> decompressed;
-		decompressed.resize(meta.uncompressed_size);
-
-		augs::decompress(
-			source_bytes.data() + pos,
-			source_bytes.size() - pos,
-			decompressed
-		);
-
-		auto s = augs::make_ptr_read_stream(decompressed);
-
-		try {
-			while (s.get_read_pos() <= decompressed.size()) {
-				demo_step step;
-				augs::read_bytes(s, step);
-				demo_steps.emplace_back(std::move(step));
-			}
-		}
-		catch (...) {
-
-		}
+	if (!meta.is_supported_format()) {
+		replay_failed_reason = "This demo was recorded in an unsupported format.";
+		pause();
 	}
 
-
 	gui.open();
 }
 
@@ -523,8 +498,10 @@ void client_setup::flush_demo_steps() {
 
 	when_last_flushed_demo = client_time;
 
+	const auto first_flushed_step = static_cast<demo_step_num_type>(recorded_demo_step - demo_steps_being_flushed.size());
+
 	future_flushed_demo = launch_async(
-		[&]() {
+		[&, first_flushed_step, keyframe_interval_steps = get_demo_keyframe_interval_steps()]() {
 #if !WEB_LOWEND
 			auto hold_fs = hold_persistent_filesystem_raii();
 #endif
@@ -537,6 +514,7 @@ void client_setup::flush_demo_steps() {
 				meta.server_address = connect_string;
 				meta.version = hypersomnia_version();
 				meta.when_recorded = augs::date_time().get_utc_timestamp();
+				meta.keyframe_interval_steps = keyframe_interval_steps;
 				augs::write_bytes(out, meta);
 
 				const auto version_info_path = augs::path_type(recorded_demo_path).replace_extension(".version.txt");
@@ -545,9 +523,7 @@ void client_setup::flush_demo_steps() {
 				was_demo_meta_written = true;
 			}
 
-			for (const auto& s : demo_steps_being_flushed) {
-				augs::write_bytes(out, s);
-			}
+			write_demo_chunk(out, demo_flush_buffers, first_flushed_step, demo_steps_being_flushed);
 
 			out.flush();
 			demo_steps_being_flushed.clear();
@@ -580,6 +556,148 @@ void client_setup::record_demo_to(const augs::path_type& p) {
 	when_last_flushed_demo = client_time;
 }
 
+bool client_setup::can_record_demo_keyframe() const {
+	if (vars.demo_keyframe_every_secs == 0) {
+		return false;
+	}
+
+	/* Only replicated state is stored, so nothing can be pending. */
+
+	const bool steady =
+		state == client_state_type::IN_GAME
+		&& !pause_solvable_stream
+		&& !now_resyncing
+		&& receiver.incoming_entropies.empty()
+		&& receiver.incoming_contexts.empty()
+		&& !receiver.next_dynamic_vars.has_value()
+	;
+
+	if (!steady) {
+		return false;
+	}
+
+	if (!when_recorded_last_keyframe.has_value()) {
+		return true;
+	}
+
+	return recorded_demo_step - *when_recorded_last_keyframe >= get_demo_keyframe_interval_steps();
+}
+
+uint32_t client_setup::get_demo_keyframe_interval_steps() const {
+	return static_cast<uint32_t>(vars.demo_keyframe_every_secs / get_inv_tickrate());
+}
+
+client_setup_snapshot client_setup::make_demo_keyframe() {
+	const auto& signi = scene.world.get_solvable().significant;
+	const auto& flavours = scene.world.get_common_significant().flavours;
+
+	auto write_all_to = [&](auto& s) {
+		augs::write_bytes(s, sv_public_vars);
+		augs::write_bytes(s, sv_dynamic_vars);
+		augs::write_bytes(s, client_player_id);
+		augs::write_bytes(s, signi);
+		augs::write_bytes(s, current_mode_state);
+
+		for (const auto& m : player_metas) {
+			augs::write_bytes(s, m.synced.public_settings);
+			augs::write_bytes(s, m.synced.is_web_client);
+		}
+
+		augs::write_bytes(s, receiver.predicted_entropies);
+	};
+
+	{
+		auto s = buffers.make_serialization_stream<net_solvable_stream_ref>(flavours, clean_round_state, signi);
+		write_all_to(s);
+	}
+
+	client_setup_snapshot keyframe;
+
+	{
+		auto s = augs::ref_memory_stream(keyframe);
+		augs::write_bytes(s, static_cast<uint32_t>(buffers.serialization.size()));
+	}
+
+	augs::compress(buffers.compression_state, buffers.serialization, keyframe);
+
+	return keyframe;
+}
+
+bool client_setup::apply_demo_keyframe(const client_setup_snapshot& keyframe) {
+	try {
+		if (keyframe.size() < sizeof(uint32_t)) {
+			throw augs::stream_read_error("Keyframe too short: %x bytes.", keyframe.size());
+		}
+
+		uint32_t uncompressed_size = 0;
+		std::memcpy(&uncompressed_size, keyframe.data(), sizeof(uint32_t));
+
+		std::vector<std::byte> uncompressed;
+		uncompressed.resize(uncompressed_size);
+
+		augs::decompress(
+			keyframe.data() + sizeof(uint32_t),
+			keyframe.size() - sizeof(uint32_t),
+			uncompressed
+		);
+
+		auto s = net_solvable_stream_cref(clean_round_state, uncompressed);
+
+		augs::read_bytes(s, sv_public_vars);
+
+		/* Loads clean_round_state which the rest of the keyframe is encoded against. */
+
+		if (!try_load_arena_according_to(sv_public_vars, false)) {
+			return false;
+		}
+
+		augs::read_bytes(s, sv_dynamic_vars);
+		augs::read_bytes(s, client_player_id);
+
+		cosmic::change_solvable_significant(
+			scene.world, 
+			[&](cosmos_solvable_significant& signi) {
+				augs::read_bytes(s, signi);
+				return changer_callback_result::REFRESH;
+			}
+		);
+
+		augs::read_bytes(s, current_mode_state);
+
+		for (auto& m : player_metas) {
+			augs::read_bytes(s, m.synced.public_settings);
+			augs::read_bytes(s, m.synced.is_web_client);
+		}
+
+		augs::read_bytes(s, receiver.predicted_entropies);
+	}
+	catch (const augs::stream_read_error& err) {
+		LOG("Failed to read a demo keyframe: %x", err.what());
+		return false;
+	}
+	catch (const augs::decompression_error& err) {
+		LOG("Failed to decompress a demo keyframe: %x", err.what());
+		return false;
+	}
+
+	state = client_state_type::IN_GAME;
+
+	auto predicted = get_arena_handle(client_arena_type::PREDICTED);
+	const auto referential = get_arena_handle(client_arena_type::REFERENTIAL);
+
+	predicted.transfer_all_solvables(referential);
+
+	receiver.clear_incoming();
+	receiver.schedule_reprediction = true;
+
+	snap_interpolated_to_logical(predicted.advanced_cosm);
+	snap_interpolated_to_logical(referential.advanced_cosm);
+
+	rebuild_player_meta_viewables = true;
+
+	return true;
+}
+
 template <class... Args>
 bool client_setup::send_payload(Args&&... args) {
 	if (is_replaying()) {
@@ -159,11 +159,13 @@ class client_setup :
 	net_time_t when_last_flushed_demo = 0.0;
 	augs::path_type recorded_demo_path;
 	demo_step_num_type recorded_demo_step = 0;
+	std::optional<demo_step_num_type> when_recorded_last_keyframe;
 	std::size_t written_messages = 0;
 
 	std::vector<demo_step> unflushed_demo_steps;
 	std::vector<demo_step> demo_steps_being_flushed;
 	augs::future<void> future_flushed_demo;
+	augs::serialization_buffers demo_flush_buffers;
 	bool was_demo_meta_written = false;
 
 	client_demo_player demo_player;
@@ -246,6 +248,11 @@ class client_setup :
 
 	void demo_replay_server_messages_from(const demo_step&);
 
+	bool can_record_demo_keyframe() const;
+	uint32_t get_demo_keyframe_interval_steps() const;
+	client_setup_snapshot make_demo_keyframe();
+	bool apply_demo_keyframe(const client_setup_snapshot&);
+
 	auto make_accumulator_input(const client_advance_input& in) {
 		auto accumulator_in = in.make_accumulator_input();
 		accumulator_in.settings.character = current_requested_settings.public_settings.character_input;
@@ -266,6 +273,19 @@ class client_setup :
 
 	void advance_demo_recorder();
 
+	template <class Callbacks>
+	void advance_demo_step(
+		const client_advance_input& in,
+		const Callbacks& callbacks,
+		const demo_step& step
+	) {
+		auto local_entropy_provider = [&]() {
+			return step.local_entropy ? *step.local_entropy : mode_entropy();
+		};
+
+		advance_single_step(in, callbacks, [&](){ demo_replay_server_messages_from(step); }, local_entropy_provider);
+	}
+
 	void detect_our_victory(const messages::match_summary_message&);
 
 	template <class Callbacks, class ServerPayloadProvider, class TotalLocalEntropyProvider>
@@ -277,6 +297,11 @@ class client_setup :
 	) {
 		if (is_recording()) {
 			unflushed_demo_steps.emplace_back();
+
+			if (can_record_demo_keyframe()) {
+				get_currently_recorded_step().keyframe = make_demo_keyframe();
+				when_recorded_last_keyframe = recorded_demo_step;
+			}
 		}
 
 		auto scope = augs::scope_guard([this]() {
@@ -633,6 +658,26 @@ public:
 
 	const cosmos& get_viewed_cosmos() const;
 
+	/*
+		Simulates the next step of the replayed demo without any audiovisual callbacks.
+		Returns false once the demo is over.
+	*/
+
+	bool resimulate_next_demo_step(const client_advance_input& in) {
+		if (!is_replaying() || demo_player.get_current_step() >= demo_player.get_total_steps()) {
+			return false;
+		}
+
+		const auto previous_step = demo_player.get_current_step();
+
+		demo_player.advance_player([&](const demo_step& step) {
+			advance_demo_step(in, solver_callbacks(), step);
+			return get_inv_tickrate();
+		});
+
+		return demo_player.get_current_step() != previous_step;
+	}
+
 	bool is_viewing_referential() const {
 		return get_viewed_arena_type() == client_arena_type::REFERENTIAL;
 	}
@@ -699,12 +744,7 @@ public:
 		if (is_replaying()) {
 			auto advance_with = [&](const demo_step& step) {
 				const auto dt = get_inv_tickrate();
-
-				auto local_entropy_provider = [&]() {
-					return step.local_entropy ? *step.local_entropy : mode_entropy();
-				};
-
-				advance_single_step(in, callbacks, [&](){ demo_replay_server_messages_from(step); }, local_entropy_provider);
+				advance_demo_step(in, callbacks, step);
 				return dt;
 			};
 
@@ -712,12 +752,7 @@ public:
 
 			auto seeking_advance = [&](const demo_step& step) {
 				const auto dt = get_inv_tickrate();
-
-				auto local_entropy_provider = [&]() {
-					return step.local_entropy ? *step.local_entropy : mode_entropy();
-				};
-
-				advance_single_step(in, solver_callbacks(), [&](){ demo_replay_server_messages_from(step); }, local_entropy_provider);
+				advance_demo_step(in, solver_callbacks(), step);
 				needs_snap = true;
 				return dt;
 			};
@@ -739,11 +774,35 @@ public:
 				demo_player = std::move(player_backup);
 			};
 
+			auto restore_keyframe = [&](const client_setup_snapshot& keyframe) {
+				/* 
+					Avatars are not part of keyframes as they would bloat them, 
+					so keep whatever was already received.
+				*/
+
+				std::vector<arena_player_avatar_payload> avatars_backup;
+
+				for (auto& m : player_metas) {
+					avatars_backup.emplace_back(std::move(m.avatar));
+				}
+
+				rewind();
+
+				for (std::size_t i = 0; i < avatars_backup.size(); ++i) {
+					player_metas[i].avatar = std::move(avatars_backup[i]);
+				}
+
+				needs_snap = true;
+
+				return apply_demo_keyframe(keyframe);
+			};
+
 			demo_player.advance(
 				in.frame_delta,
 				advance_with,
 				seeking_advance,
 				rewind,
+				restore_keyframe,
 				get_inv_tickrate()
 			);
 
@@ -0,0 +1,104 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/filesystem/file.h"
+
+#include "view/audiovisual_state/systems/interpolation_system.h"
+#include "view/audiovisual_state/systems/past_infection_system.h"
+
+#include "application/network/simulation_receiver_settings.h"
+#include "application/setups/client/lag_compensation_settings.h"
+#include "application/setups/client/client_setup.h"
+#include "application/setups/client/demo_benchmark.h"
+#include "application/arena/arena_handle.hpp"
+
+bool benchmark_demo(
+	const packaged_official_content& official,
+	const client_vars& vars,
+	const demo_benchmark_settings& settings
+) {
+	LOG("Benchmarking demo: %x", settings.demo_path);
+
+	const auto connect_string = std::string(demo_address_preffix_v) + settings.demo_path.string();
+
+	auto setup = std::make_unique<client_setup>(
+		official,
+		connect_string,
+		"",
+		vars,
+		nat_detection_settings(),
+		port_type(0),
+		std::nullopt,
+		""
+	);
+
+	if (!setup->is_replaying()) {
+		LOG("Failed to open the demo.");
+		return false;
+	}
+
+	const auto screen_size = vec2i(1920, 1080);
+	const auto receiver_settings = simulation_receiver_settings();
+	const auto lag_compensation = lag_compensation_settings();
+
+	network_profiler network_performance;
+	network_info network_stats {};
+
+	interpolation_system interp;
+	past_infection_system past_infection;
+
+	const auto in = client_advance_input {
+		augs::delta::zero,
+		screen_size,
+		input_settings(),
+		1.f,
+		receiver_settings,
+		lag_compensation,
+		network_performance,
+		network_stats,
+		interp,
+		past_infection
+	};
+
+	const auto hash_every = std::max(settings.hash_every_steps, uint32_t(1));
+
+	std::string hash_trail;
+	std::size_t num_steps = 0;
+
+	augs::timer total_timer;
+
+	while (setup->resimulate_next_demo_step(in)) {
+		++num_steps;
+
+		if (num_steps % hash_every == 0) {
+			const auto& cosm = setup->get_arena_handle(client_arena_type::REFERENTIAL).get_cosmos();
+
+			hash_trail += typesafe_sprintf(
+				"%x: %x\n",
+				cosm.get_total_steps_passed(),
+				cosm.calculate_solvable_signi_hash<uint32_t>()
+			);
+		}
+	}
+
+	const auto total_secs = total_timer.get<std::chrono::seconds>();
+
+	std::string report;
+
+	report += typesafe_sprintf("Demo: %x\n", settings.demo_path);
+	report += typesafe_sprintf("Re-simulated %x steps in %f2 s (%f2 steps/s).\n", num_steps, total_secs, num_steps / std::max(total_secs, 1e-9));
+
+	report += "\nReferential cosmos:\n";
+	setup->get_arena_handle(client_arena_type::REFERENTIAL).get_cosmos().profiler.totals_summary(report);
+
+	report += typesafe_sprintf("\nSolvable hashes every %x steps:\n", hash_every);
+	report += hash_trail;
+
+	LOG("%x", report);
+
+	if (!settings.report_path.empty()) {
+		augs::save_as_text(settings.report_path, report);
+		LOG("Wrote the benchmark report to %x", settings.report_path);
+	}
+
+	return num_steps > 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include "augs/filesystem/path_declaration.h"
+
+struct packaged_official_content;
+struct client_vars;
+
+struct demo_benchmark_settings {
+	augs::path_type demo_path;
+	augs::path_type report_path;
+	uint32_t hash_every_steps = 60;
+};
+
+/*
+	Re-simulates a recorded demo as fast as possible, without a window or audio,
+	then reports the time spent in every system of the referential cosmos
+	together with a trail of solvable hashes.
+
+	Two runs over the same demo must yield an identical hash trail,
+	so the report can serve both as a benchmark and as a regression gate for the solver.
+*/
+
+bool benchmark_demo(
+	const packaged_official_content& official,
+	const client_vars& vars,
+	const demo_benchmark_settings& settings
+);
@@ -8,6 +8,25 @@ struct demo_step;
 using demo_step_num_type = augs::snapshotted_player_step_type;
 using demo_step_map = std::map<demo_step_num_type, demo_step>;
 
+/* Ascending numbers of the steps that carry a keyframe. */
+using demo_keyframe_index = std::vector<demo_step_num_type>;
+
+/*
+	After demo_file_meta, a demo file is a sequence of chunks, one per flush of the recorder.
+	Each chunk is a header followed by the LZ4-compressed steps it holds,
+	so that any chunk can be found and decoded without reading the rest of the file.
+*/
+
+struct demo_chunk_header {
+	// GEN INTROSPECTOR struct demo_chunk_header
+	demo_step_num_type first_step = 0;
+	uint32_t num_steps = 0;
+	uint32_t uncompressed_size = 0;
+	uint32_t compressed_size = 0;
+	demo_keyframe_index keyframes;
+	// END GEN INTROSPECTOR
+};
+
 struct demo_file {
 	// GEN INTROSPECTOR struct demo_file
 	demo_file_meta meta;
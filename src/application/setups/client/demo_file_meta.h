@@ -3,12 +3,30 @@
 #include "augs/misc/constant_size_string.h"
 #include "augs/network/network_types.h"
 
+/*
+	Every demo begins with the magic, followed by the format version.
+	Bump the version whenever the layout of demo_file_meta, demo_chunk_header or demo_step changes,
+	so that older demos are rejected on load instead of being misparsed.
+
+	Demos recorded before the magic existed begin with the length of the server name,
+	which is at most max_server_name_length_v and so can never be mistaken for the magic.
+*/
+
+constexpr uint32_t demo_file_magic_v = 0x4d454448; /* "HDEM" */
+constexpr uint32_t demo_format_version_v = 1;
+
 struct demo_file_meta {
 	// GEN INTROSPECTOR struct demo_file_meta
+	uint32_t magic = demo_file_magic_v;
+	uint32_t format_version = demo_format_version_v;
 	server_name_type server_name;
 	address_string_type server_address;
 	hypersomnia_version version;
 	version_timestamp_string when_recorded;
-	int64_t uncompressed_size = 0;
+	uint32_t keyframe_interval_steps = 0;
 	// END GEN INTROSPECTOR
+
+	bool is_supported_format() const {
+		return magic == demo_file_magic_v && format_version == demo_format_version_v;
+	}
 };
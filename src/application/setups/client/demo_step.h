@@ -15,16 +15,26 @@ using server_message_variant = transform_types_in_list_t<
 	std::add_pointer_t
 >;
 
+using client_setup_snapshot = std::vector<std::byte>;
+
 struct demo_step {
 	// GEN INTROSPECTOR struct demo_step
 	std::optional<mode_entropy> local_entropy;
 	mutable std::vector<std::vector<std::byte>> serialized_messages;
+	client_setup_snapshot keyframe;
 	// END GEN INTROSPECTOR
 
 	/*
 		serialized_messages needs to be mutable,
 		because we need to potentially resize it to a multiple of 4 for yojimbo::ReadStream to work properly.
 	*/
-};
 
-using client_setup_snapshot = std::vector<std::byte>;
+	/*
+		If not empty, keyframe holds the compressed replicated state of the client
+		right before this step was applied, so that the player can seek without replaying from the start.
+	*/
+
+	bool has_keyframe() const {
+		return !keyframe.empty();
+	}
+};
@@ -0,0 +1,422 @@
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/filesystem/file.h"
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/misc/compress.h"
+#include "augs/misc/serialization_buffers.h"
+
+#include "application/setups/client/demo_step_reader.h"
+
+void write_demo_chunk(
+	std::ofstream& out,
+	augs::serialization_buffers& buffers,
+	const demo_step_num_type first_step,
+	const std::vector<demo_step>& steps
+) {
+	auto& serialized = buffers.serialization;
+	auto& compressed = buffers.compressed;
+
+	demo_chunk_header header;
+	header.first_step = first_step;
+	header.num_steps = static_cast<uint32_t>(steps.size());
+
+	{
+		serialized.clear();
+		auto s = augs::ref_memory_stream(serialized);
+
+		for (std::size_t i = 0; i < steps.size(); ++i) {
+			const auto& step = steps[i];
+
+			if (step.has_keyframe()) {
+				header.keyframes.push_back(static_cast<demo_step_num_type>(first_step + i));
+			}
+
+			augs::write_bytes(s, step);
+		}
+	}
+
+	compressed.clear();
+	augs::compress(buffers.compression_state, serialized, compressed);
+
+	header.uncompressed_size = static_cast<uint32_t>(serialized.size());
+	header.compressed_size = static_cast<uint32_t>(compressed.size());
+
+	augs::write_bytes(out, header);
+	out.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+}
+
+demo_file_meta demo_step_reader::open(const augs::path_type& path) {
+	source_path = path;
+
+	chunks.clear();
+	window.clear();
+	keyframes.clear();
+	total_steps = 0;
+
+	const auto file_size = static_cast<std::size_t>(augs::get_file_size(path));
+
+	auto source = augs::open_binary_input_stream(path);
+
+	demo_file_meta meta;
+	augs::read_bytes(source, meta);
+
+	if (!meta.is_supported_format()) {
+		if (meta.magic != demo_file_magic_v) {
+			LOG("Demo %x was recorded before the current demo format and cannot be played.", path);
+		}
+		else {
+			LOG("Demo %x has an unsupported format (%x). Expected: %x.", path, meta.format_version, demo_format_version_v);
+		}
+
+		return meta;
+	}
+
+	try {
+		while (static_cast<std::size_t>(source.tellg()) < file_size) {
+			chunk_entry entry;
+			augs::read_bytes(source, entry.header);
+
+			entry.offset = static_cast<std::size_t>(source.tellg());
+
+			const auto& h = entry.header;
+
+			const bool truncated = entry.offset + h.compressed_size > file_size;
+			const bool discontinuous = h.first_step != total_steps;
+
+			if (truncated || discontinuous) {
+				LOG("Demo %x ends with a broken chunk at step %x.", path, h.first_step);
+				break;
+			}
+
+			source.seekg(h.compressed_size, std::ios::cur);
+
+			keyframes.insert(keyframes.end(), h.keyframes.begin(), h.keyframes.end());
+			total_steps += h.num_steps;
+
+			chunks.emplace_back(std::move(entry));
+		}
+	}
+	catch (const augs::stream_read_error& err) {
+		LOG("Demo %x ends with a truncated chunk header: %x", path, err.what());
+	}
+	catch (const augs::file_open_error& err) {
+		LOG("Demo %x ends with a truncated chunk header: %x", path, err.what());
+	}
+
+	return meta;
+}
+
+std::size_t demo_step_reader::find_chunk_of(const demo_step_num_type n) const {
+	const auto it = std::upper_bound(
+		chunks.begin(),
+		chunks.end(),
+		n,
+		[](const demo_step_num_type step, const chunk_entry& c) {
+			return step < c.header.first_step;
+		}
+	);
+
+	return static_cast<std::size_t>(std::distance(chunks.begin(), it)) - 1;
+}
+
+demo_step_reader::decoded_chunk& demo_step_reader::decode(const std::size_t chunk_index) {
+	for (auto& d : window) {
+		if (d.chunk_index == chunk_index) {
+			d.last_used = ++num_uses;
+			return d;
+		}
+	}
+
+	if (window.size() >= max_decoded_chunks) {
+		const auto least_recently_used = std::min_element(
+			window.begin(),
+			window.end(),
+			[](const decoded_chunk& a, const decoded_chunk& b) {
+				return a.last_used < b.last_used;
+			}
+		);
+
+		window.erase(least_recently_used);
+	}
+
+	const auto& entry = chunks[chunk_index];
+	const auto& h = entry.header;
+
+	{
+		auto source = augs::open_binary_input_stream(source_path);
+		source.seekg(entry.offset);
+
+		compressed.resize(h.compressed_size);
+		source.read(reinterpret_cast<char*>(compressed.data()), compressed.size());
+	}
+
+	uncompressed.resize(h.uncompressed_size);
+	augs::decompress(compressed.data(), compressed.size(), uncompressed);
+
+	decoded_chunk result;
+	result.chunk_index = chunk_index;
+	result.last_used = ++num_uses;
+	result.steps.resize(h.num_steps);
+
+	auto s = augs::make_ptr_read_stream(uncompressed);
+
+	for (auto& step : result.steps) {
+		augs::read_bytes(s, step);
+	}
+
+	window.emplace_back(std::move(result));
+	return window.back();
+}
+
+const demo_step* demo_step_reader::find(const demo_step_num_type n) {
+	if (n >= total_steps) {
+		return nullptr;
+	}
+
+	const auto chunk_index = find_chunk_of(n);
+
+	try {
+		const auto& decoded = decode(chunk_index);
+		return std::addressof(decoded.steps[n - chunks[chunk_index].header.first_step]);
+	}
+	catch (const augs::stream_read_error& err) {
+		LOG("Failed to read demo chunk %x: %x", chunk_index, err.what());
+	}
+	catch (const augs::decompression_error& err) {
+		LOG("Failed to decompress demo chunk %x: %x", chunk_index, err.what());
+	}
+	catch (const augs::file_open_error& err) {
+		LOG("Failed to open the demo to read chunk %x: %x", chunk_index, err.what());
+	}
+
+	return nullptr;
+}
+
+#if BUILD_UNIT_TESTS
+#include <cstring>
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/filesystem/directory.h"
+#include "application/setups/client/client_demo_player.h"
+#include "all_paths.h"
+
+TEST_CASE("DemoChunks RecordAndReadBack") {
+	const auto path = CACHE_DIR / "test_demo_chunks.dem";
+
+	augs::create_directories_for(path);
+	augs::remove_file(path);
+
+	auto make_step = [](const demo_step_num_type n) {
+		demo_step step;
+		step.serialized_messages.push_back({ std::byte(n & 0xff), std::byte(n >> 8), std::byte(7) });
+
+		if (n % 25 == 0) {
+			step.keyframe = { std::byte(1), std::byte(n & 0xff) };
+		}
+
+		return step;
+	};
+
+	const std::size_t steps_per_chunk = 40;
+	const std::size_t num_chunks = 5;
+
+	{
+		augs::serialization_buffers buffers;
+		auto out = augs::open_binary_output_stream_append(path);
+
+		demo_file_meta meta;
+		meta.server_address = "127.0.0.1";
+		augs::write_bytes(out, meta);
+
+		for (std::size_t c = 0; c < num_chunks; ++c) {
+			std::vector<demo_step> steps;
+
+			for (std::size_t i = 0; i < steps_per_chunk; ++i) {
+				steps.push_back(make_step(static_cast<demo_step_num_type>(c * steps_per_chunk + i)));
+			}
+
+			write_demo_chunk(out, buffers, static_cast<demo_step_num_type>(c * steps_per_chunk), steps);
+		}
+
+		/* A header promising more bytes than follow, as if the game crashed while flushing. */
+		demo_chunk_header truncated;
+		truncated.first_step = static_cast<demo_step_num_type>(num_chunks * steps_per_chunk);
+		truncated.num_steps = 1;
+		truncated.compressed_size = 1000;
+		augs::write_bytes(out, truncated);
+	}
+
+	demo_step_reader reader;
+	const auto meta = reader.open(path);
+
+	REQUIRE(meta.server_address == std::string("127.0.0.1"));
+	REQUIRE(reader.get_num_chunks() == num_chunks);
+	REQUIRE(reader.size() == num_chunks * steps_per_chunk);
+	REQUIRE(reader.get_keyframes() == demo_keyframe_index { 0, 25, 50, 75, 100, 125, 150, 175 });
+
+	auto check_step = [&](const demo_step_num_type n) {
+		const auto step = reader.find(n);
+		REQUIRE(step != nullptr);
+
+		const auto expected = make_step(n);
+		REQUIRE(step->serialized_messages == expected.serialized_messages);
+		REQUIRE(step->keyframe == expected.keyframe);
+		REQUIRE(!step->local_entropy.has_value());
+	};
+
+	/* Forward, then backward, so that chunks are evicted and decoded again. */
+	for (demo_step_num_type n = 0; n < reader.size(); ++n) {
+		check_step(n);
+	}
+
+	for (demo_step_num_type n = reader.size(); n-- > 0;) {
+		check_step(n);
+	}
+
+	REQUIRE(reader.find(reader.size()) == nullptr);
+
+	augs::remove_file(path);
+}
+
+TEST_CASE("DemoChunks RejectsDemosWithoutMagic") {
+	const auto path = CACHE_DIR / "test_demo_without_magic.dem";
+
+	augs::create_directories_for(path);
+	augs::remove_file(path);
+
+	{
+		/* The meta of demos from before the format version, starting with a 1-character server name. */
+		server_name_type server_name = "a";
+
+		auto out = augs::open_binary_output_stream_append(path);
+		augs::write_bytes(out, server_name);
+		augs::write_bytes(out, address_string_type("127.0.0.1"));
+		augs::write_bytes(out, hypersomnia_version());
+		augs::write_bytes(out, version_timestamp_string());
+		augs::write_bytes(out, int64_t(0));
+
+		for (int i = 0; i < 64; ++i) {
+			augs::write_bytes(out, uint32_t(1));
+		}
+	}
+
+	demo_step_reader reader;
+	const auto meta = reader.open(path);
+
+	REQUIRE(!meta.is_supported_format());
+	REQUIRE(reader.size() == 0);
+	REQUIRE(reader.get_num_chunks() == 0);
+
+	augs::remove_file(path);
+}
+
+TEST_CASE("DemoChunks SeekingWithKeyframesMatchesFullReplay") {
+	/*
+		The replicated state is simulated with a running hash of the steps.
+		Like the client does, each keyframe holds the state right before its step was applied.
+	*/
+
+	const auto path = CACHE_DIR / "test_demo_keyframes.dem";
+
+	augs::create_directories_for(path);
+	augs::remove_file(path);
+
+	using state_type = uint64_t;
+
+	auto apply = [](state_type& state, const demo_step& step) {
+		state = state * 1099511628211ull + static_cast<state_type>(step.serialized_messages[0][0]) + 1;
+	};
+
+	const demo_step_num_type num_steps = 200;
+	const demo_step_num_type steps_per_chunk = 40;
+	const demo_step_num_type keyframe_interval = 25;
+
+	std::vector<state_type> state_before;
+
+	{
+		augs::serialization_buffers buffers;
+		auto out = augs::open_binary_output_stream_append(path);
+
+		demo_file_meta meta;
+		meta.keyframe_interval_steps = keyframe_interval;
+		augs::write_bytes(out, meta);
+
+		state_type state = 0;
+		std::vector<demo_step> chunk;
+
+		for (demo_step_num_type n = 0; n < num_steps; ++n) {
+			demo_step step;
+			step.serialized_messages.push_back({ std::byte((n * 37) % 251) });
+
+			if (n > 0 && n % keyframe_interval == 0) {
+				step.keyframe.resize(sizeof(state));
+				std::memcpy(step.keyframe.data(), &state, sizeof(state));
+			}
+
+			state_before.push_back(state);
+			apply(state, step);
+
+			chunk.emplace_back(std::move(step));
+
+			if (chunk.size() == steps_per_chunk) {
+				write_demo_chunk(out, buffers, n + 1 - steps_per_chunk, chunk);
+				chunk.clear();
+			}
+		}
+
+		state_before.push_back(state);
+	}
+
+	client_demo_player player;
+	player.play_demo_from(path);
+
+	REQUIRE(player.replay_failed_reason.empty());
+	REQUIRE(player.get_total_steps() == num_steps);
+
+	state_type state = 0;
+	int num_rewinds = 0;
+	int num_restores = 0;
+
+	auto step_state = [&](const demo_step& step) {
+		apply(state, step);
+		return 0.0;
+	};
+
+	auto rewind_state = [&]() {
+		state = 0;
+		++num_rewinds;
+	};
+
+	auto restore_keyframe = [&](const client_setup_snapshot& keyframe) {
+		if (keyframe.size() != sizeof(state)) {
+			return false;
+		}
+
+		std::memcpy(&state, keyframe.data(), sizeof(state));
+		++num_restores;
+		return true;
+	};
+
+	auto seek = [&](const demo_step_num_type target) {
+		player.seek_to(target);
+		player.advance(augs::delta::zero, step_state, step_state, rewind_state, restore_keyframe, 1 / 60.0);
+
+		REQUIRE(player.get_current_step() == target);
+		REQUIRE(state == state_before[target]);
+	};
+
+	seek(130);
+	seek(60);
+	seek(199);
+	seek(24);
+	seek(75);
+	seek(200);
+	seek(0);
+
+	REQUIRE(num_restores == 5);
+	REQUIRE(num_rewinds == 2);
+
+	augs::remove_file(path);
+}
+#endif
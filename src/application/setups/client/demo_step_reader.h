@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "augs/filesystem/path_declaration.h"
+#include "application/setups/client/demo_file.h"
+#include "application/setups/client/demo_step.h"
+
+namespace augs {
+	struct serialization_buffers;
+}
+
+/* Appends a chunk holding the passed steps, the first of which is numbered first_step. */
+
+void write_demo_chunk(
+	std::ofstream& out,
+	augs::serialization_buffers& buffers,
+	demo_step_num_type first_step,
+	const std::vector<demo_step>& steps
+);
+
+/*
+	Reads a demo lazily.
+
+	Opening only walks the chunk headers to build the index.
+	Steps are decoded a whole chunk at a time on first access,
+	and only the few most recently used chunks are kept decoded,
+	so the memory used does not depend on the length of the demo.
+*/
+
+class demo_step_reader {
+	struct chunk_entry {
+		demo_chunk_header header;
+		std::size_t offset = 0;
+	};
+
+	struct decoded_chunk {
+		std::size_t chunk_index = 0;
+		uint64_t last_used = 0;
+		std::vector<demo_step> steps;
+	};
+
+	augs::path_type source_path;
+
+	std::vector<chunk_entry> chunks;
+	std::vector<decoded_chunk> window;
+	uint64_t num_uses = 0;
+
+	demo_step_num_type total_steps = 0;
+	demo_keyframe_index keyframes;
+
+	std::vector<std::byte> compressed;
+	std::vector<std::byte> uncompressed;
+
+	std::size_t find_chunk_of(demo_step_num_type) const;
+	decoded_chunk& decode(std::size_t chunk_index);
+
+public:
+	static constexpr std::size_t max_decoded_chunks = 3;
+
+	/* Returns the meta. A truncated last chunk is ignored, e.g. when the game crashed while recording. */
+	demo_file_meta open(const augs::path_type& path);
+
+	/* Returns nullptr past the end, or if the chunk turns out to be corrupt. */
+	const demo_step* find(demo_step_num_type);
+
+	demo_step_num_type size() const {
+		return total_steps;
+	}
+
+	const demo_keyframe_index& get_keyframes() const {
+		return keyframes;
+	}
+
+	std::size_t get_num_chunks() const {
+		return chunks.size();
+	}
+};
@@ -29,3 +29,30 @@ void editor_setup::rebuild_arena(const bool editor_preview) {
 
 	inspected_to_entity_selector_state();
 }
+
+void editor_setup::rebuild_arena_nodes(const std::vector<editor_node_id>& nodes) {
+	const bool for_playtesting = true;
+	const auto override_game_mode = game_mode_name_type("");
+
+	const bool refreshed = ::rebuild_arena_nodes_in_place<editor_arena_handle<false>>(
+		get_arena_handle(),
+		{
+			project,
+			override_game_mode,
+			paths.project_folder,
+			official,
+			std::addressof(scene_entity_to_node),
+			std::addressof(clean_round_state),
+			for_playtesting,
+			true /* editor_preview */
+		},
+		nodes
+	);
+
+	if (!refreshed) {
+		rebuild_arena();
+		return;
+	}
+
+	inspected_to_entity_selector_state();
+}
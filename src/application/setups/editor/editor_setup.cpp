@@ -1613,8 +1613,12 @@ void editor_setup::undo() {
 
 		bool should_rebuild = true;
 		bool should_rescan_missing = true;
+		bool rebuild_in_place = false;
 
-		auto check_rebuild = [&]<typename T>(const T&) {
+		thread_local std::vector<editor_node_id> affected_nodes;
+		affected_nodes.clear();
+
+		auto check_rebuild = [&]<typename T>(const T& command) {
 			if constexpr(skip_scene_rebuild_v<T>) {
 				should_rebuild = false;
 			}
@@ -1622,6 +1626,8 @@ void editor_setup::undo() {
 			if constexpr(skip_missing_resources_check_v<T>) {
 				should_rescan_missing = false;
 			}
+
+			rebuild_in_place = gather_nodes_rebuilt_in_place(command, affected_nodes);
 		};
 
 		std::visit(check_rebuild, history.last_command());
@@ -1630,7 +1636,12 @@ void editor_setup::undo() {
 		gui.filesystem.clear_drag_drop();
 
 		if (should_rebuild) {
-			rebuild_arena();
+			if (rebuild_in_place) {
+				rebuild_arena_nodes(affected_nodes);
+			}
+			else {
+				rebuild_arena();
+			}
 		}
 
 		if (should_rescan_missing) {
@@ -1655,8 +1666,12 @@ void editor_setup::redo() {
 
 		bool should_rebuild = true;
 		bool should_rescan_missing = true;
+		bool rebuild_in_place = false;
 
-		auto check_rebuild = [&]<typename T>(const T&) {
+		thread_local std::vector<editor_node_id> affected_nodes;
+		affected_nodes.clear();
+
+		auto check_rebuild = [&]<typename T>(const T& command) {
 			if constexpr(skip_scene_rebuild_v<T>) {
 				should_rebuild = false;
 			}
@@ -1664,6 +1679,8 @@ void editor_setup::redo() {
 			if constexpr(skip_missing_resources_check_v<T>) {
 				should_rescan_missing = false;
 			}
+
+			rebuild_in_place = gather_nodes_rebuilt_in_place(command, affected_nodes);
 		};
 
 		std::visit(check_rebuild, history.next_command());
@@ -1679,7 +1696,12 @@ void editor_setup::redo() {
 		*/
 
 		if (should_rebuild) {
-			rebuild_arena();
+			if (rebuild_in_place) {
+				rebuild_arena_nodes(affected_nodes);
+			}
+			else {
+				rebuild_arena();
+			}
 		}
 
 		if (should_rescan_missing) {
@@ -521,6 +521,12 @@ public:
 
 	void rebuild_arena(const bool editor_preview = true);
 
+	/* Falls back to rebuild_arena if some of the nodes can't be refreshed in place. */
+	void rebuild_arena_nodes(const std::vector<editor_node_id>& nodes);
+
+	template <class T>
+	bool gather_nodes_rebuilt_in_place(const T& command, std::vector<editor_node_id>& into) const;
+
 	const auto& get_paths() const {
 		return paths;
 	}
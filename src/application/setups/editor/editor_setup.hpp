@@ -30,13 +30,71 @@ constexpr bool skip_missing_resources_check_v = is_one_of_v<T,
 	toggle_layers_active_command
 >;
 
+/*
+	Commands that only change the properties or transforms of existing nodes.
+	They don't have to rebuild the whole arena, only the entities of the affected nodes.
+*/
+
+template <class T>
+bool editor_setup::gather_nodes_rebuilt_in_place(const T& command, std::vector<editor_node_id>& into) const {
+	if constexpr(is_edit_node_command_v<T>) {
+		for (const auto& e : command.entries) {
+			into.push_back(e.node_id.operator editor_node_id());
+		}
+
+		return true;
+	}
+	else if constexpr(is_one_of_v<T, move_nodes_command, resize_nodes_command, flip_nodes_command>) {
+		bool all_mapped = true;
+
+		auto gather_from = [&](const auto& entities) {
+			entities.for_each([&](const auto id) {
+				const auto node_id = to_node_id(entity_id(id));
+
+				if (!node_id.is_set()) {
+					/* Not backed by any node, so only the full rebuild can restore it. */
+					all_mapped = false;
+				}
+
+				into.push_back(node_id);
+			});
+		};
+
+		if constexpr(std::is_same_v<T, move_nodes_command>) {
+			gather_from(command.moved_entities);
+		}
+		else if constexpr(std::is_same_v<T, resize_nodes_command>) {
+			gather_from(command.resized_entities);
+		}
+		else {
+			gather_from(command.flipped_entities);
+		}
+
+		return all_mapped;
+	}
+	else {
+		(void)command;
+		(void)into;
+
+		return false;
+	}
+}
+
 template <class T>
 const T& editor_setup::post_new_command(T&& command) {
 	gui.history.scroll_to_latest_once = true;
 	const T& result = history.execute_new(std::forward<T>(command), make_command_input(true));
 
 	if constexpr(!skip_scene_rebuild_v<T>) {
-		rebuild_arena();
+		thread_local std::vector<editor_node_id> affected_nodes;
+		affected_nodes.clear();
+
+		if (gather_nodes_rebuilt_in_place(result, affected_nodes)) {
+			rebuild_arena_nodes(affected_nodes);
+		}
+		else {
+			rebuild_arena();
+		}
 	}
 
 	if constexpr(!skip_missing_resources_check_v<T>) {
@@ -60,10 +118,30 @@ const T& editor_setup::post_new_command(T&& command) {
 
 template <class T>
 const T& editor_setup::rewrite_last_command(T&& command) {
+	/* 
+		Nodes affected by the rewritten command have to be refreshed too,
+		since undoing it might have restored them.
+	*/
+
+	thread_local std::vector<editor_node_id> affected_nodes;
+	affected_nodes.clear();
+
+	const bool rewritten_in_place = std::visit(
+		[&](const auto& rewritten) {
+			return gather_nodes_rebuilt_in_place(rewritten, affected_nodes);
+		},
+		history.last_command()
+	);
+
 	history.undo(make_command_input(true));
 	const T& result = history.execute_new(std::forward<T>(command), make_command_input(true));
 
-	rebuild_arena(); 
+	if (rewritten_in_place && gather_nodes_rebuilt_in_place(result, affected_nodes)) {
+		rebuild_arena_nodes(affected_nodes);
+	}
+	else {
+		rebuild_arena(); 
+	}
 
 	if constexpr(!skip_missing_resources_check_v<remove_cref<T>>) {
 		on_resource_references_changed();
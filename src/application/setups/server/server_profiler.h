@@ -11,6 +11,8 @@ struct server_profiler : public augs::profiler_mixin<server_profiler> {
 	augs::time_measurements solve_simulation;
 	augs::time_measurements send_entropies;
 	augs::time_measurements send_packets;
+
+	augs::amount_measurements<std::size_t> skipped_entropy_serializations = 1;
 	// END GEN INTROSPECTOR
 };
 
@@ -684,7 +684,6 @@ server_setup::server_setup(
 ) : 
 	integrated_client_vars(integrated_client_vars),
 	official(official),
-	last_loaded_project(std::make_unique<editor_project>()),
 	last_start(in),
 	assigned_teams(assigned_teams),
 	dedicated(dedicated),
@@ -2506,27 +2505,20 @@ void server_setup::apply_nonzoomedout_visible_world_area(const vec2 area) {
 }
 
 void register_external_resources_of(
-	const editor_project& project,
+	const editor_project_readwrite::external_resource_database& external_resources,
 	const augs::path_type& arena_folder_path,
 	arena_files_database_type& database
 ) {
-	project.resources.pools.for_each_container(
-		[&]<typename P>(const P& pool) {
-			using R = typename P::mapped_type;
-
-			if constexpr(is_pathed_resource_v<R>) {
-				for (auto& resource : pool) {
-					const auto& file = resource.external_file;
-					database[augs::to_secure_hash_byte_format(file.file_hash)] = { arena_folder_path / file.path_in_project, {} };
-				}
-			}
-		}
-	);
+	for (const auto& [path_in_project, file_hash] : external_resources) {
+		database[file_hash] = { arena_folder_path / path_in_project, {} };
+	}
 }
 
 void server_setup::rechoose_arena() {
 	LOG("Choosing arena: %x", vars.arena);
 
+	arena_snapshot.invalidate();
+
 	const auto& arena = get_arena_handle();
 
 	{
@@ -2538,7 +2530,7 @@ void server_setup::rechoose_arena() {
 			vars.game_mode,
 			clean_round_state,
 			vars.playtesting_context,
-			std::addressof(*last_loaded_project),
+			nullptr,
 			nullptr
 		});
 
@@ -2550,7 +2542,7 @@ void server_setup::rechoose_arena() {
 		LOG("Chosen arena hash: %x", current_arena_hash);
 
 		::register_external_resources_of(
-			*last_loaded_project,
+			result.external_resources,
 			current_arena_folder,
 			arena_files_database
 		);
@@ -2670,22 +2662,34 @@ void server_setup::accept_entropy_of_client(
 
 void server_setup::send_full_arena_snapshot_to(const client_id_type client_id) {
 	const auto sent_client_id = static_cast<uint32_t>(client_id);
+	const auto current_step = scene.world.get_total_steps_passed();
 
-	server->send_payload(
-		client_id, 
-		game_channel_type::RELIABLE_MESSAGES, 
-
-		buffers,
+	if (!arena_snapshot.is_valid_for(current_step)) {
+		::compress_arena_snapshot_body(
+			buffers,
 
-		clean_round_state,
-		scene.world.get_common_significant().flavours,
+			clean_round_state,
+			scene.world.get_common_significant().flavours,
 
-		full_arena_snapshot_payload<true> {
 			scene.world.get_solvable().significant,
 			current_mode_state,
-			sent_client_id,
-			get_rcon_level(client_id)
-		}
+
+			arena_snapshot.compressed_body
+		);
+
+		arena_snapshot.step = current_step;
+	}
+	else {
+		LOG("Reusing the arena snapshot compressed at step: %x", current_step);
+	}
+
+	server->send_payload(
+		client_id, 
+		game_channel_type::RELIABLE_MESSAGES, 
+
+		arena_snapshot,
+		sent_client_id,
+		get_rcon_level(client_id)
 	);
 }
 
@@ -3568,38 +3572,80 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 		return std::nullopt;
 	}();
 
-	auto send_total_entropy = [&](const auto client_id, auto& c) {
+	auto should_receive_entropy = [&](const auto& c) {
 		if (c.should_pause_solvable_stream()) {
-			return;
+			return false;
 		}
 
 		const bool its_time_already = 
 			c.state >= client_state_type::RECEIVING_INITIAL_SNAPSHOT
 		;
 
-		if (!its_time_already) {
+		return its_time_already;
+	};
+
+	std::size_t num_recipients = 0;
+
+	for_each_id_and_client(
+		[&](const auto, const auto& c) {
+			if (should_receive_entropy(c)) {
+				++num_recipients;
+			}
+		},
+		only_connected_v
+	);
+
+	if (num_recipients == 0) {
+		return;
+	}
+
+	/* 
+		Only the prestep_client_context differs between recipients,
+		so the rest is serialized once and multicast as the same bits.
+	*/
+
+	const auto shared_body = [&]() -> std::shared_ptr<const preserialized_step_entropy_body> {
+		auto body = std::make_shared<preserialized_step_entropy_body>();
+
+		if (!preserialize_shared_step_entropy(total, *body)) {
+			return nullptr;
+		}
+
+		return body;
+	}();
+
+	profiler.skipped_entropy_serializations.measure(shared_body ? num_recipients - 1 : 0);
+
+	auto send_total_entropy = [&](const auto client_id, auto& c) {
+		if (!should_receive_entropy(c)) {
 			return;
 		}
 
-		{
-			{
-				auto context = prestep_client_context();
-				context.num_entropies_accepted = c.num_entropies_accepted;
+		auto context = prestep_client_context();
+		context.num_entropies_accepted = c.num_entropies_accepted;
 
-				total.context = context;
-			}
+		/* Reset the counter */
+		c.num_entropies_accepted = 0;
+
+		if (shared_body != nullptr) {
+			server->send_payload(
+				client_id,
+				game_channel_type::RELIABLE_MESSAGES,
 
-			/* Reset the counter */
-			c.num_entropies_accepted = 0;
+				context,
+				shared_body
+			);
 		}
+		else {
+			total.context = context;
 
-		/* TODO PERFORMANCE: only serialize the message once and multicast the same buffer to all clients! */
-		server->send_payload(
-			client_id,
-			game_channel_type::RELIABLE_MESSAGES,
+			server->send_payload(
+				client_id,
+				game_channel_type::RELIABLE_MESSAGES,
 
-			total
-		);
+				total
+			);
+		}
 	};
 
 	for_each_id_and_client(send_total_entropy, only_connected_v);
@@ -4385,13 +4431,14 @@ void server_setup::log_performance() {
 				profiler.prepare_summary_info();
 
 				const auto summary = typesafe_sprintf(
-					"S: %3f, SS: %3f, AA: %3f, ACS: %3f, SE: %3f, SP: %3f",
+					"S: %3f, SS: %3f, AA: %3f, ACS: %3f, SE: %3f, SP: %3f, SKIP: %x",
 					1000 * profiler.step.get_summary_info().value,
 					1000 * profiler.solve_simulation.get_summary_info().value,
 					1000 * profiler.advance_adapter.get_summary_info().value,
 					1000 * profiler.advance_clients_state.get_summary_info().value,
 					1000 * profiler.send_entropies.get_summary_info().value,
-					1000 * profiler.send_packets.get_summary_info().value
+					1000 * profiler.send_packets.get_summary_info().value,
+					profiler.skipped_entropy_serializations.get_summary_info().value
 				);
 
 				last_logged_at = server_time;
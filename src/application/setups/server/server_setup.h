@@ -21,6 +21,7 @@
 #include "application/setups/server/server_client_state.h"
 #include "augs/readwrite/memory_stream_declaration.h"
 #include "augs/misc/serialization_buffers.h"
+#include "application/network/arena_snapshot_cache.h"
 
 #include "application/network/server_step_entropy.h"
 #if !HEADLESS
@@ -60,7 +61,6 @@ struct add_to_arena_input {
 class server_adapter;
 
 struct resolve_address_result;
-struct editor_project;
 
 struct arena_files_database_entry {
 	augs::path_type path;
@@ -121,7 +121,6 @@ class server_setup :
 
 	const packaged_official_content& official;
 
-	std::unique_ptr<editor_project> last_loaded_project;
 	arena_files_database_type arena_files_database;
 
 	augs::server_listen_input last_start;
@@ -149,6 +148,7 @@ class server_setup :
 	}
 
 	augs::serialization_buffers buffers;
+	arena_snapshot_cache arena_snapshot;
 
 	entropy_accumulator local_collected;
 	std::vector<mode_player_id> moved_to_spectators;
@@ -623,6 +623,8 @@ public:
 				}
 			}
 
+			arena_snapshot.invalidate();
+
 			const auto advanced_dt = get_inv_tickrate();
 			server_time += advanced_dt;
 
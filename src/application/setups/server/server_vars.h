@@ -150,7 +150,7 @@ struct server_vars {
 
 	uint32_t max_buffered_client_commands = 1000;
 
-	uint32_t state_hash_once_every_tick = 1;
+	uint32_t state_hash_once_every_tick = 10;
 	float send_net_statistics_update_once_every_secs = 1;
 
 	float max_kick_ban_linger_secs = 2;
@@ -61,7 +61,7 @@ namespace augs {
 					// set_listener_orientation({ 0.f, 0.f, 1.f, 0.f, -1.f, 0.f }); //  - towards screen
 				}
 				else if constexpr(same<C, update_multiple_properties>) {
-					const auto& source = source_pool[t.proxy_id];
+					auto& source = source_pool[t.proxy_id];
 					const auto& si = t.si;
 
 					source.set_position(si, t.position);
@@ -125,7 +125,7 @@ namespace augs {
 					source.set_gain(t.gain);
 				}
 				else if constexpr(same<C, reseek_to_sync_if_needed>) {
-					const auto& source = source_pool[t.proxy_id];
+					auto& source = source_pool[t.proxy_id];
 					const auto actual_secs = source.get_time_in_seconds();
 
 					if (std::abs(t.expected_secs - actual_secs) > t.max_divergence) {
@@ -178,6 +178,12 @@ namespace augs {
 
 			std::visit(command_handler, cmd.payload);
 		}
+
+		flash_noise_source.update_stream();
+
+		for (auto& s : source_pool) {
+			s.update_stream();
+		}
 #else
 		(void)c;
 		(void)n;
@@ -48,6 +48,17 @@ namespace augs {
 
 	single_sound_buffer::single_sound_buffer(const sound_data& data) : single_sound_buffer(data, sound_buffer_loading_settings()) {}
 
+	single_sound_buffer::single_sound_buffer(std::unique_ptr<encoded_sound_data> data) : encoded(std::move(data)) {
+		AL_CHECK(alGenBuffers(1, &id));
+
+#if TRACE_CONSTRUCTORS_DESTRUCTORS
+		++g_num_buffers;
+		LOG("alGenBuffers: %x (now %x buffers)", id, g_num_buffers);
+#endif
+		initialized = true;
+		meta.computed_length_in_seconds = encoded->compute_length_in_seconds();
+	}
+
 	single_sound_buffer::~single_sound_buffer() {
 		destroy();
 	}
@@ -55,7 +66,8 @@ namespace augs {
 	single_sound_buffer::single_sound_buffer(single_sound_buffer&& b) : 
 		meta(std::move(b.meta)),
 		id(b.id),
-		initialized(b.initialized)
+		initialized(b.initialized),
+		encoded(std::move(b.encoded))
 	{
 		b.initialized = false;
 		b.meta = {};
@@ -67,6 +79,7 @@ namespace augs {
 		meta = std::move(b.meta);
 		id = b.id;
 		initialized = b.initialized;
+		encoded = std::move(b.encoded);
 
 		b.initialized = false;
 		b.meta = {};
@@ -134,7 +147,17 @@ namespace augs {
 
 	void sound_buffer::from_file(const sound_buffer_loading_input input) {
 		const auto& path = input.source_sound;
-		variations.emplace_back(path, input.settings);
+
+		auto add_variation = [&](const augs::path_type& variation_path) {
+			if (input.streamed) {
+				variations.emplace_back(std::make_unique<encoded_sound_data>(variation_path));
+			}
+			else {
+				variations.emplace_back(sound_data(variation_path, input.decoded_cache_dir), input.settings);
+			}
+		};
+
+		add_variation(path);
 
 		const auto ext = augs::path_type(path).extension();
 		const auto without_ext = augs::path_type(path).replace_extension("").string();
@@ -146,7 +169,7 @@ namespace augs {
 				const auto next_path = augs::path_type(typesafe_sprintf("%x_%x%x", without_num, i, ext));
 
 				try {
-					variations.emplace_back(next_path, input.settings);
+					add_variation(next_path);
 				}
 				catch (...) {
 					break;
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <memory>
 #include <optional>
 
 #include "augs/audio/sound_buffer_structs.h"
@@ -9,6 +10,7 @@ using ALenum = int;
 
 namespace augs {
 	struct sound_data;
+	struct encoded_sound_data;
 
 	ALenum get_openal_format_of(const sound_data&);
 
@@ -16,6 +18,7 @@ namespace augs {
 		sound_buffer_meta meta;
 		ALuint id = 0;
 		bool initialized = false;
+		std::unique_ptr<encoded_sound_data> encoded;
 		
 		void set_data(const sound_data&);
 		void destroy();
@@ -24,6 +27,13 @@ namespace augs {
 		single_sound_buffer(const sound_data&);
 		single_sound_buffer(const sound_data&, sound_buffer_loading_settings);
 
+		/*
+			A streamed buffer holds no samples.
+			Its id only identifies it to the sources, which decode the encoded data in chunks.
+		*/
+
+		single_sound_buffer(std::unique_ptr<encoded_sound_data>);
+
 		~single_sound_buffer();
 
 		single_sound_buffer(single_sound_buffer&& b);
@@ -40,6 +50,14 @@ namespace augs {
 		const auto& get_meta() const {
 			return meta;
 		}
+
+		bool is_streamed() const {
+			return encoded != nullptr;
+		}
+
+		const encoded_sound_data& get_encoded() const {
+			return *encoded;
+		}
 	};
 
 	class sound_buffer {
@@ -21,5 +21,9 @@ namespace augs {
 	struct sound_buffer_loading_input {
 		const augs::path_type source_sound;
 		const sound_buffer_loading_settings settings;
+		const augs::path_type decoded_cache_dir = {};
+
+		/* Keep the file encoded in memory and decode it in chunks while it plays. */
+		const bool streamed = false;
 	};
 }
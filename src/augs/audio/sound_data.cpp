@@ -4,6 +4,7 @@
 #endif
 
 #include <cstring>
+#include <algorithm>
 
 #include "augs/misc/scope_guard.h"
 #include "augs/audio/sound_data.h"
@@ -11,6 +12,9 @@
 #include "augs/filesystem/file.h"
 #include "augs/audio/sound_data.h"
 #include "augs/build_settings/setting_log_audio_files.h"
+#include "augs/filesystem/directory.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/misc/secure_hash.h"
 
 
 #if BUILD_SOUND_FORMAT_DECODERS
@@ -23,7 +27,149 @@ auto fclosed_unique(T* const ptr) {
 }
 
 namespace augs {
-	sound_data::sound_data(const path_type& path) {
+	struct decoded_sound_cache_header {
+		static constexpr uint32_t current_version = 2;
+
+		uint32_t version = current_version;
+		int32_t frequency = 0;
+		int32_t channels = 0;
+		uint64_t num_samples = 0;
+		secure_hash_type source_hash = {};
+	};
+
+	static path_type get_decoded_sound_cache_path(const path_type& decoded_cache_dir, const path_type& source_path) {
+		return decoded_cache_dir / (std::string(augs::to_hex_format(augs::secure_hash(source_path.string()))) + ".pcm");
+	}
+
+	static bool read_decoded_sound_cache(
+		const path_type& cache_path,
+		const secure_hash_type& source_hash,
+		std::vector<sound_sample_type>& samples,
+		int& frequency,
+		int& channels
+	) {
+		if (!augs::exists(cache_path)) {
+			return false;
+		}
+
+		try {
+			const auto bytes = augs::file_to_bytes(cache_path);
+
+			decoded_sound_cache_header header;
+
+			if (bytes.size() < sizeof(header)) {
+				return false;
+			}
+
+			std::memcpy(&header, bytes.data(), sizeof(header));
+
+			const auto samples_bytes = header.num_samples * sizeof(sound_sample_type);
+
+			if (header.version != decoded_sound_cache_header::current_version || bytes.size() != sizeof(header) + samples_bytes) {
+				/* Old format or truncated, e.g. if the game was closed while writing. */
+				return false;
+			}
+
+			if (header.source_hash != source_hash) {
+				/* The source has changed since. */
+				return false;
+			}
+
+			samples.resize(header.num_samples);
+			std::memcpy(samples.data(), bytes.data() + sizeof(header), samples_bytes);
+
+			/* Mark the entry as recently used for trim_decoded_sound_cache. */
+			std::error_code err;
+			std::filesystem::last_write_time(cache_path, std::filesystem::file_time_type::clock::now(), err);
+
+			frequency = header.frequency;
+			channels = header.channels;
+
+			return true;
+		}
+		catch (...) {
+			return false;
+		}
+	}
+
+	static void write_decoded_sound_cache(
+		const path_type& cache_path,
+		const secure_hash_type& source_hash,
+		const std::vector<sound_sample_type>& samples,
+		const int frequency,
+		const int channels
+	) {
+		decoded_sound_cache_header header;
+		header.frequency = frequency;
+		header.channels = channels;
+		header.num_samples = samples.size();
+		header.source_hash = source_hash;
+
+		std::vector<std::byte> bytes;
+		bytes.resize(sizeof(header) + samples.size() * sizeof(sound_sample_type));
+
+		std::memcpy(bytes.data(), &header, sizeof(header));
+		std::memcpy(bytes.data() + sizeof(header), samples.data(), samples.size() * sizeof(sound_sample_type));
+
+		try {
+			augs::create_directories_for(cache_path);
+			augs::bytes_to_file(bytes, cache_path);
+		}
+		catch (...) {
+			/* The cache is only an optimization. */
+		}
+	}
+
+	void trim_decoded_sound_cache(const path_type& decoded_cache_dir, const uint64_t max_bytes) {
+		struct entry {
+			path_type path;
+			std::filesystem::file_time_type used_when;
+			uint64_t size = 0;
+		};
+
+		std::vector<entry> entries;
+
+		try {
+			if (!augs::exists(decoded_cache_dir)) {
+				return;
+			}
+
+			auto skip_directory = [](auto&&...) { return callback_result::CONTINUE; };
+
+			augs::for_each_in_directory(
+				decoded_cache_dir,
+				skip_directory,
+				[&](const path_type& p) {
+					if (p.extension() == ".pcm") {
+						entries.push_back({ p, augs::last_write_time(p), static_cast<uint64_t>(augs::get_file_size(p)) });
+					}
+
+					return callback_result::CONTINUE;
+				}
+			);
+		}
+		catch (...) {
+			return;
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+			return a.used_when > b.used_when;
+		});
+
+		uint64_t total_bytes = 0;
+
+		for (const auto& e : entries) {
+			total_bytes += e.size;
+
+			if (total_bytes > max_bytes) {
+				augs::remove_file(e.path);
+			}
+		}
+	}
+
+	sound_data::sound_data(const path_type& path) : sound_data(path, {}) {}
+
+	sound_data::sound_data(const path_type& path, const path_type& decoded_cache_dir) {
 		channels = 1;
 
 		if (path.empty()) {
@@ -34,23 +180,42 @@ namespace augs {
 		const auto extension = path.extension();
 		const auto path_str = path.string();
 
-        if (extension == ".ogg") {
-            short* decoded_samples = nullptr;
+		if (extension == ".ogg") {
+			const auto contents = augs::file_to_bytes(path);
 
-            // Decode the file
-            int samples_output = stb_vorbis_decode_filename(path_str.c_str(), &channels, &frequency, &decoded_samples);
-            if (samples_output < 0) {
-                // Handle error
-                throw sound_decoding_error("Failed to decode %x as OGG file. STB error code: %x", path, samples_output);
-            }
+			path_type cache_path;
+			secure_hash_type contents_hash = {};
 
-            // Use decoded_samples and samples_output as needed
-            samples.resize(samples_output * channels);
-            std::memcpy(samples.data(), decoded_samples, samples_output * channels * sizeof(short));
+			if (!decoded_cache_dir.empty()) {
+				cache_path = get_decoded_sound_cache_path(decoded_cache_dir, path);
+				contents_hash = augs::secure_hash(contents);
+			}
 
-            // Free the decoded_samples buffer
-            free(decoded_samples);
-        }
+			if (cache_path.empty() || !read_decoded_sound_cache(cache_path, contents_hash, samples, frequency, channels)) {
+				short* decoded_samples = nullptr;
+
+				const int samples_output = stb_vorbis_decode_memory(
+					reinterpret_cast<const unsigned char*>(contents.data()),
+					static_cast<int>(contents.size()),
+					&channels,
+					&frequency,
+					&decoded_samples
+				);
+
+				if (samples_output < 0) {
+					throw sound_decoding_error("Failed to decode %x as OGG file. STB error code: %x", path, samples_output);
+				}
+
+				auto freer = augs::scope_guard([decoded_samples]() { free(decoded_samples); });
+
+				samples.resize(samples_output * channels);
+				std::memcpy(samples.data(), decoded_samples, samples_output * channels * sizeof(short));
+
+				if (!cache_path.empty()) {
+					write_decoded_sound_cache(cache_path, contents_hash, samples, frequency, channels);
+				}
+			}
+		}
 		else if (extension == ".wav") {
 #if PLATFORM_UNIX
 			auto wav_file = fclosed_unique(fopen(path_str.c_str(), "rbe"));
@@ -144,4 +309,162 @@ namespace augs {
 	double sound_data::compute_length_in_seconds() const {
 		return static_cast<double>(samples.size()) / (frequency * channels);
 	}
+
+	encoded_sound_data::encoded_sound_data(const path_type& path) {
+		if (path.extension() != ".ogg") {
+			throw sound_decoding_error("Failed to stream %x: only OGG files can be streamed.", path);
+		}
+
+#if BUILD_SOUND_FORMAT_DECODERS
+		bytes = augs::file_to_bytes(path);
+
+		int error = 0;
+
+		auto* const v = stb_vorbis_open_memory(
+			reinterpret_cast<const unsigned char*>(bytes.data()),
+			static_cast<int>(bytes.size()),
+			&error,
+			nullptr
+		);
+
+		if (v == nullptr) {
+			throw sound_decoding_error("Failed to open %x as OGG file. STB error code: %x", path, error);
+		}
+
+		const auto info = stb_vorbis_get_info(v);
+
+		frequency = static_cast<int>(info.sample_rate);
+		channels = 2;
+		num_frames = stb_vorbis_stream_length_in_samples(v);
+
+		stb_vorbis_close(v);
+
+		if (info.channels != 1 && info.channels != 2) {
+			throw sound_decoding_error("Failed to stream %x: %x channels are not supported.", path, info.channels);
+		}
+#else
+		throw sound_decoding_error("Failed to stream %x: sound decoders were not built.", path);
+#endif
+	}
+
+	double encoded_sound_data::compute_length_in_seconds() const {
+		return static_cast<double>(num_frames) / frequency;
+	}
+
+	sound_decoder::sound_decoder(const encoded_sound_data& data) {
+#if BUILD_SOUND_FORMAT_DECODERS
+		int error = 0;
+
+		auto* const v = stb_vorbis_open_memory(
+			reinterpret_cast<const unsigned char*>(data.bytes.data()),
+			static_cast<int>(data.bytes.size()),
+			&error,
+			nullptr
+		);
+
+		if (v != nullptr) {
+			source_channels = stb_vorbis_get_info(v).channels;
+		}
+
+		handle = v;
+#else
+		(void)data;
+#endif
+	}
+
+	sound_decoder::~sound_decoder() {
+#if BUILD_SOUND_FORMAT_DECODERS
+		if (handle != nullptr) {
+			stb_vorbis_close(static_cast<stb_vorbis*>(handle));
+		}
+#endif
+	}
+
+	std::size_t sound_decoder::decode(sound_sample_type* const output, const std::size_t max_frames) {
+#if BUILD_SOUND_FORMAT_DECODERS
+		if (handle == nullptr) {
+			return 0;
+		}
+
+		auto* const v = static_cast<stb_vorbis*>(handle);
+
+		std::size_t total = 0;
+
+		while (total < max_frames) {
+			const auto frames = stb_vorbis_get_samples_short_interleaved(
+				v, 
+				source_channels,
+				output + total * 2,
+				static_cast<int>((max_frames - total) * source_channels)
+			);
+
+			if (frames <= 0) {
+				break;
+			}
+
+			if (source_channels == 1) {
+				/* Same as MONO_TO_STEREO for the fully decoded sounds. Expand in place, from the back. */
+				auto* const decoded = output + total * 2;
+
+				for (int i = frames - 1; i >= 0; --i) {
+					decoded[i * 2] = decoded[i];
+					decoded[i * 2 + 1] = decoded[i];
+				}
+			}
+
+			total += static_cast<std::size_t>(frames);
+		}
+
+		return total;
+#else
+		(void)output;
+		(void)max_frames;
+		return 0;
+#endif
+	}
+
+	void sound_decoder::seek(const uint64_t frame) {
+#if BUILD_SOUND_FORMAT_DECODERS
+		if (handle != nullptr) {
+			stb_vorbis_seek(static_cast<stb_vorbis*>(handle), static_cast<unsigned>(frame));
+		}
+#else
+		(void)frame;
+#endif
+	}
+}
+
+#if BUILD_UNIT_TESTS && BUILD_SOUND_FORMAT_DECODERS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("SoundDecoder MatchesFullDecode") {
+	const auto path = augs::path_type("content/menu/menu/sfx/garden_ambience.ogg");
+
+	const auto full = augs::sound_data(path);
+	const auto encoded = augs::encoded_sound_data(path);
+
+	REQUIRE(full.channels == 2);
+	REQUIRE(encoded.frequency == full.frequency);
+	REQUIRE(encoded.num_frames * 2 == full.samples.size());
+
+	augs::sound_decoder decoder(encoded);
+
+	/* Odd chunk sizes so that the chunks straddle the OGG pages. */
+	std::vector<augs::sound_sample_type> chunk(1237 * 2);
+	std::vector<augs::sound_sample_type> streamed;
+
+	while (const auto frames = decoder.decode(chunk.data(), 1237)) {
+		streamed.insert(streamed.end(), chunk.begin(), chunk.begin() + frames * 2);
+	}
+
+	REQUIRE(streamed == full.samples);
+
+	const auto middle = encoded.num_frames / 2;
+	decoder.seek(middle);
+
+	const auto frames = decoder.decode(chunk.data(), 1237);
+
+	REQUIRE(frames == 1237);
+	REQUIRE(std::equal(chunk.begin(), chunk.end(), full.samples.begin() + middle * 2));
 }
+#endif
@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 #include "augs/filesystem/path.h"
 #include "augs/templates/exception_templates.h"
 
@@ -17,6 +19,56 @@ namespace augs {
 
 		sound_data(const path_type& path);
 
+		/*
+			Decoded OGGs are cached as raw PCM under decoded_cache_dir.
+			Every source path has a single cache file that is rewritten whenever the contents of the source change,
+			so a sound is decoded only once per change and stale versions do not pile up.
+			Pass an empty path to always decode.
+		*/
+
+		sound_data(const path_type& path, const path_type& decoded_cache_dir);
+
+		double compute_length_in_seconds() const;
+	};
+
+	/* Removes the least recently used entries of decoded_cache_dir until the rest fits in max_bytes. */
+	void trim_decoded_sound_cache(const path_type& decoded_cache_dir, uint64_t max_bytes);
+
+	/*
+		A long OGG kept compressed in memory,
+		so that sources can decode it chunk by chunk instead of holding all of its samples.
+	*/
+
+	struct encoded_sound_data {
+		std::vector<std::byte> bytes;
+		int frequency = 0;
+		int channels = 0;
+		uint64_t num_frames = 0;
+
+		encoded_sound_data(const path_type& path);
+
 		double compute_length_in_seconds() const;
 	};
-}
\ No newline at end of file
+
+	/*
+		Decodes interleaved stereo samples, like those of sound_data, out of encoded_sound_data.
+		The encoded bytes must outlive the decoder.
+	*/
+
+	class sound_decoder {
+		void* handle = nullptr;
+		int source_channels = 0;
+
+	public:
+		sound_decoder(const encoded_sound_data&);
+		~sound_decoder();
+
+		sound_decoder(const sound_decoder&) = delete;
+		sound_decoder& operator=(const sound_decoder&) = delete;
+
+		/* Returns the number of frames written to output, which is less than max_frames only at the end. */
+		std::size_t decode(sound_sample_type* output, std::size_t max_frames);
+
+		void seek(uint64_t frame);
+	};
+}
@@ -18,6 +18,7 @@
 
 #include "augs/audio/sound_source.h"
 #include "augs/audio/sound_buffer.h"
+#include "augs/audio/sound_stream.h"
 
 #include "augs/audio/OpenAL_error.h"
 
@@ -73,7 +74,9 @@ namespace augs {
 		initialized(b.initialized),
 		id(b.id),
 		attached_buffer(b.attached_buffer),
-		buffer_meta(std::move(b.buffer_meta))
+		buffer_meta(std::move(b.buffer_meta)),
+		stream(std::move(b.stream)),
+		rewind_stream(b.rewind_stream)
 	{
 		b.initialized = false;
 		b.buffer_meta = {};
@@ -86,6 +89,8 @@ namespace augs {
 		id = b.id;
 		attached_buffer = b.attached_buffer;
 		buffer_meta = std::move(b.buffer_meta);
+		stream = std::move(b.stream);
+		rewind_stream = b.rewind_stream;
 
 		b.buffer_meta = {};
 		b.initialized = false;
@@ -96,6 +101,7 @@ namespace augs {
 	void sound_source::destroy() {
 		if (initialized) {
 			stop();
+			reset_stream();
 #if TRACE_CONSTRUCTORS_DESTRUCTORS
 			--g_num_sources;
 			LOG("alDeleteSources: %x (now %x sources)", id, g_num_sources);
@@ -115,17 +121,50 @@ namespace augs {
 		return get_id();
 	}
 
+	void sound_source::reset_stream() {
+		if (stream) {
+			/* The queued buffers must be released before the stream deletes them. */
+			AL_CHECK(alSourceStop(id));
+			AL_CHECK(alSourcei(id, AL_BUFFER, 0));
+
+			stream.reset();
+			rewind_stream = false;
+		}
+	}
+
 	void sound_source::play() {
+		if (stream && rewind_stream) {
+			stream->start(id, 0.0);
+			rewind_stream = false;
+		}
+
 		AL_CHECK(alSourcePlay(id));
 		stopped = false;
 	}
 	
-	void sound_source::seek_to(const float seconds) const {
+	void sound_source::seek_to(const float seconds) {
+		if (stream) {
+			const bool was_playing = is_playing();
+
+			stream->start(id, seconds);
+			rewind_stream = false;
+
+			if (was_playing) {
+				AL_CHECK(alSourcePlay(id));
+			}
+
+			return;
+		}
+
 		(void)seconds;
 		AL_CHECK(alSourcef(id, AL_SEC_OFFSET, seconds));
 	}
 	
 	float sound_source::get_time_in_seconds() const {
+		if (stream) {
+			return static_cast<float>(stream->get_time_in_seconds(id));
+		}
+
 		float seconds = 0.f;
 		AL_CHECK(alGetSourcef(id, AL_SEC_OFFSET, &seconds));
 		return seconds;
@@ -134,9 +173,16 @@ namespace augs {
 	void sound_source::stop() {
 		AL_CHECK(alSourceStop(id));
 		stopped = true;
+		rewind_stream = stream != nullptr;
 	}
 	
-	void sound_source::set_looping(const bool loop) const {
+	void sound_source::set_looping(const bool loop) {
+		if (stream) {
+			/* AL_LOOPING would loop the queue instead of the sound. */
+			stream->set_looping(loop);
+			return;
+		}
+
 		(void)loop;
 		AL_CHECK(alSourcei(id, AL_LOOPING, loop));
 #if TRACE_PARAMETERS
@@ -297,6 +343,12 @@ namespace augs {
 
 		ALenum state = 0xdeadbeef;
 		AL_CHECK(alGetSourcei(id, AL_SOURCE_STATE, &state));
+
+		if (stream) {
+			/* Between an underrun and the next update_stream the source is briefly stopped. */
+			return state == AL_PLAYING || !stream->has_finished();
+		}
+
 		return state == AL_PLAYING;
 #else
 		return false;
@@ -327,7 +379,17 @@ namespace augs {
 			stop();
 		}
 
-		AL_CHECK(alSourcei(id, AL_BUFFER, buf.get_id()));
+		reset_stream();
+
+		if (buf.is_streamed()) {
+			stream = std::make_unique<sound_stream>(buf.get_encoded());
+
+			AL_CHECK(alSourcei(id, AL_LOOPING, AL_FALSE));
+			stream->start(id, 0.0);
+		}
+		else {
+			AL_CHECK(alSourcei(id, AL_BUFFER, buf.get_id()));
+		}
 #if TRACE_PARAMETERS
 		LOG_NVPS(buf.get_id());
 #endif
@@ -352,8 +414,20 @@ namespace augs {
 	void sound_source::unbind_buffer() {
 		attached_buffer = 0;
 		buffer_meta = {};
+		reset_stream();
 		AL_CHECK(alSourcei(id, AL_BUFFER, 0));
 	}
+
+	void sound_source::update_stream() {
+		if (stream == nullptr || stopped) {
+			return;
+		}
+
+		if (stream->update(id)) {
+			/* The queue ran dry before it was refilled. */
+			AL_CHECK(alSourcePlay(id));
+		}
+	}
 	
 	void sound_source::just_play(const single_sound_buffer& buffer, const float gain) {
 		if (gain >= 0.f) {
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <memory>
 #include <stdexcept>
 
 #include "augs/math/vec2.h"
@@ -19,6 +20,7 @@ namespace augs {
 namespace augs {
 	class single_sound_buffer;
 	class sound_buffer;
+	class sound_stream;
 
 	void set_listener_velocity(const si_scaling, vec2);
 	void set_listener_position(const si_scaling, vec2);
@@ -31,6 +33,10 @@ namespace augs {
 		ALuint attached_buffer = -1;
 		sound_buffer_meta buffer_meta;
 
+		std::unique_ptr<sound_stream> stream;
+		bool rewind_stream = false;
+
+		void reset_stream();
 		void destroy();
 	public:
 		sound_source();
@@ -46,9 +52,9 @@ namespace augs {
 		void set_relative_and_zero_vel_pos() const;
 
 		void play();
-		void seek_to(float seconds) const;
+		void seek_to(float seconds);
 		void stop();
-		void set_looping(bool) const;
+		void set_looping(bool);
 		void set_doppler_factor(float) const;
 		void set_rolloff_factor(float) const;
 		void set_pitch(float) const;
@@ -76,6 +82,9 @@ namespace augs {
 
 		void unbind_buffer();
 
+		/* Refills the queue of a streamed buffer. Call regularly on the thread that plays the source. */
+		void update_stream();
+
 		const sound_buffer_meta& get_bound_buffer_meta() const {
 			return buffer_meta;
 		}
@@ -0,0 +1,171 @@
+#include <algorithm>
+
+#if BUILD_OPENAL
+#include <AL/al.h>
+#include <AL/alc.h>
+#endif
+
+#include "augs/audio/OpenAL_error.h"
+#include "augs/audio/sound_stream.h"
+
+namespace augs {
+	sound_stream::sound_stream(const encoded_sound_data& data) : data(data), decoder(data) {
+		AL_CHECK(alGenBuffers(static_cast<ALsizei>(num_buffers), buffers.data()));
+	}
+
+	sound_stream::~sound_stream() {
+		AL_CHECK(alDeleteBuffers(static_cast<ALsizei>(num_buffers), buffers.data()));
+	}
+
+	void sound_stream::start(const ALuint source, const double seconds) {
+		AL_CHECK(alSourceStop(source));
+
+		/* Releases every queued buffer at once. */
+		AL_CHECK(alSourcei(source, AL_BUFFER, 0));
+
+		first_queued = 0;
+		num_queued = 0;
+		reached_end = false;
+
+		auto frame = static_cast<uint64_t>(std::max(0.0, seconds) * data.frequency);
+
+		if (data.num_frames > 0) {
+			frame = looping ? frame % data.num_frames : std::min(frame, data.num_frames);
+		}
+
+		decoder.seek(frame);
+
+		first_queued_frame = frame;
+		next_decoded_frame = frame;
+
+		while (num_queued < num_buffers && !reached_end) {
+			if (!fill_and_queue(source, buffers[num_queued])) {
+				break;
+			}
+		}
+	}
+
+	bool sound_stream::fill_and_queue(const ALuint source, const ALuint buffer) {
+		chunk.resize(frames_per_buffer * 2);
+
+		std::size_t filled = 0;
+		bool just_rewound = false;
+
+		while (filled < frames_per_buffer) {
+			const auto decoded = decoder.decode(chunk.data() + filled * 2, frames_per_buffer - filled);
+
+			filled += decoded;
+			next_decoded_frame += decoded;
+
+			if (filled == frames_per_buffer) {
+				break;
+			}
+
+			/* The decoder has reached the end. */
+
+			if (!looping || (decoded == 0 && just_rewound)) {
+				reached_end = true;
+				break;
+			}
+
+			decoder.seek(0);
+			next_decoded_frame = 0;
+			just_rewound = decoded == 0;
+		}
+
+		if (filled == 0) {
+			return false;
+		}
+
+#if BUILD_OPENAL
+		const auto bytesize = filled * 2 * sizeof(sound_sample_type);
+
+		AL_CHECK(alBufferData(buffer, AL_FORMAT_STEREO16, chunk.data(), static_cast<ALsizei>(bytesize), static_cast<ALsizei>(data.frequency)));
+		AL_CHECK(alSourceQueueBuffers(source, 1, &buffer));
+#else
+		(void)source;
+		(void)buffer;
+#endif
+
+		queued_frames[(first_queued + num_queued) % num_buffers] = static_cast<uint32_t>(filled);
+		++num_queued;
+
+		return true;
+	}
+
+	void sound_stream::unqueue_processed(const ALuint source) {
+#if BUILD_OPENAL
+		ALint processed = 0;
+		AL_CHECK(alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed));
+
+		for (; processed > 0 && num_queued > 0; --processed) {
+			ALuint unqueued = 0;
+			AL_CHECK(alSourceUnqueueBuffers(source, 1, &unqueued));
+
+			first_queued_frame += queued_frames[first_queued];
+
+			if (data.num_frames > 0) {
+				first_queued_frame %= data.num_frames;
+			}
+
+			first_queued = (first_queued + 1) % num_buffers;
+			--num_queued;
+		}
+#else
+		(void)source;
+#endif
+	}
+
+	bool sound_stream::update(const ALuint source) {
+		unqueue_processed(source);
+
+		while (num_queued < num_buffers && !reached_end) {
+			if (!fill_and_queue(source, buffers[(first_queued + num_queued) % num_buffers])) {
+				break;
+			}
+		}
+
+#if BUILD_OPENAL
+		ALint state = 0;
+		AL_CHECK(alGetSourcei(source, AL_SOURCE_STATE, &state));
+
+		return state == AL_STOPPED && num_queued > 0;
+#else
+		return false;
+#endif
+	}
+
+	void sound_stream::set_looping(const bool flag) {
+		if (flag && !looping && reached_end) {
+			/* Carry on decoding from the start. */
+			decoder.seek(0);
+			next_decoded_frame = 0;
+			reached_end = false;
+		}
+
+		looping = flag;
+	}
+
+	bool sound_stream::has_finished() const {
+		return reached_end && num_queued == 0;
+	}
+
+	double sound_stream::get_time_in_seconds(const ALuint source) const {
+		uint64_t frame = first_queued_frame;
+
+#if BUILD_OPENAL
+		ALint offset = 0;
+		AL_CHECK(alGetSourcei(source, AL_SAMPLE_OFFSET, &offset));
+
+		frame += static_cast<uint64_t>(std::max(0, offset));
+#else
+		(void)source;
+#endif
+
+		if (data.num_frames > 0) {
+			frame %= data.num_frames;
+		}
+
+		return static_cast<double>(frame) / data.frequency;
+	}
+}
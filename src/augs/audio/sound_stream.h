@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "augs/audio/sound_data.h"
+
+using ALuint = unsigned int;
+
+namespace augs {
+	/*
+		Plays an encoded_sound_data on a single source through a small queue of buffers,
+		which update refills with freshly decoded chunks as the source consumes them.
+
+		All functions must be called on the thread that owns the source.
+		The source must be detached from the queue (alSourcei(AL_BUFFER, 0)) before the stream is destroyed.
+	*/
+
+	class sound_stream {
+		static constexpr std::size_t num_buffers = 4;
+		static constexpr std::size_t frames_per_buffer = 16384;
+
+		const encoded_sound_data& data;
+		sound_decoder decoder;
+
+		std::array<ALuint, num_buffers> buffers = {};
+		std::array<uint32_t, num_buffers> queued_frames = {};
+
+		std::size_t first_queued = 0;
+		std::size_t num_queued = 0;
+
+		uint64_t first_queued_frame = 0;
+		uint64_t next_decoded_frame = 0;
+
+		bool looping = false;
+		bool reached_end = false;
+
+		std::vector<sound_sample_type> chunk;
+
+		bool fill_and_queue(ALuint source, ALuint buffer);
+		void unqueue_processed(ALuint source);
+
+	public:
+		sound_stream(const encoded_sound_data&);
+		~sound_stream();
+
+		sound_stream(const sound_stream&) = delete;
+		sound_stream& operator=(const sound_stream&) = delete;
+
+		/* Stops the source and queues the chunks that follow the given time. */
+		void start(ALuint source, double seconds);
+
+		/* Returns true if the source has run out of queued chunks even though there are more to play. */
+		bool update(ALuint source);
+
+		void set_looping(bool);
+
+		bool has_finished() const;
+		double get_time_in_seconds(ALuint source) const;
+	};
+}
@@ -0,0 +1,173 @@
+#include "3rdparty/imgui/imgui.h"
+#include "augs/string/typesafe_sprintf.h"
+#include "augs/templates/remove_cref.h"
+#include "augs/graphics/vertex.h"
+#include "augs/graphics/renderer_command.h"
+#include "augs/graphics/null_renderer_backend.h"
+
+namespace augs {
+	namespace graphics {
+		std::string renderer_backend_stats::summary() const {
+			return typesafe_sprintf(
+				"Commands: %x\nDrawcalls: %x\nTriangles: %x\nLines: %x\nUploaded: %x KB\n",
+				commands,
+				drawcalls,
+				triangles,
+				lines,
+				uploaded_bytes / 1024
+			);
+		}
+
+		void null_renderer_backend::perform(
+			renderer_backend_result& output,
+			const renderer_command* const c,
+			const std::size_t n,
+			const dedicated_buffers& dedicated
+		) {
+			ImDrawList* cmd_list = nullptr;
+			std::size_t cmd_i = 0;
+
+			auto account_drawcall = [&](const drawcall_command& cmd) {
+				if (cmd.count == 0) {
+					return;
+				}
+
+				++stats.drawcalls;
+
+				if (cmd.triangles) {
+					stats.triangles += cmd.count;
+					stats.uploaded_bytes += sizeof(vertex_triangle) * cmd.count;
+				}
+
+				if (cmd.lines) {
+					stats.lines += cmd.count;
+					stats.uploaded_bytes += sizeof(vertex_line) * cmd.count;
+				}
+
+				if (cmd.specials) {
+					stats.uploaded_bytes += sizeof(special) * cmd.count * 3;
+				}
+			};
+
+			auto account_buffers = [&](const triangles_and_specials& buffers) {
+				if (const auto lines_n = buffers.lines.size(); lines_n > 0) {
+					drawcall_command cmd;
+
+					cmd.lines = buffers.lines.data();
+					cmd.count = static_cast<uint32_t>(lines_n);
+
+					account_drawcall(cmd);
+				}
+
+				if (const auto triangles_n = buffers.triangles.size(); triangles_n > 0) {
+					drawcall_command cmd;
+
+					cmd.triangles = buffers.triangles.data();
+					cmd.count = static_cast<uint32_t>(triangles_n);
+
+					if (buffers.specials.size() > 0) {
+						cmd.specials = buffers.specials.data();
+					}
+
+					account_drawcall(cmd);
+				}
+			};
+
+			for (std::size_t i = 0; i < n; ++i) {
+				++stats.commands;
+
+				auto command_handler = [&](const auto& typed_cmd) {
+					using C = remove_cref<decltype(typed_cmd)>;
+
+					if constexpr(std::is_same_v<C, drawcall_command>) {
+						account_drawcall(typed_cmd);
+					}
+					else if constexpr(std::is_same_v<C, drawcall_custom_buffer_command>) {
+						drawcall_command cmd;
+
+						cmd.triangles = typed_cmd.buffer.data();
+						cmd.count = static_cast<uint32_t>(typed_cmd.buffer.size());
+
+						account_drawcall(cmd);
+					}
+					else if constexpr(std::is_same_v<C, drawcall_dedicated_command>) {
+						account_buffers(dedicated[typed_cmd.type]);
+					}
+					else if constexpr(std::is_same_v<C, drawcall_dedicated_vector_command>) {
+						account_buffers(dedicated[typed_cmd.type][typed_cmd.index]);
+					}
+					else if constexpr(std::is_same_v<C, setup_imgui_list>) {
+						cmd_list = typed_cmd.cmd_list;
+						cmd_i = 0;
+
+						stats.uploaded_bytes += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+						stats.uploaded_bytes += cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+
+						/* The caller still owns the cleanup of the list, exactly as with the real backend. */
+						output.imgui_lists_to_delete.emplace_back(cmd_list);
+					}
+					else if constexpr(std::is_same_v<C, no_arg_command>) {
+						if (typed_cmd == no_arg_command::IMGUI_CMD) {
+							if (cmd_list != nullptr) {
+								const auto& cc = cmd_list->CmdBuffer[cmd_i++];
+
+								++stats.drawcalls;
+								stats.triangles += cc.ElemCount / 3;
+							}
+						}
+						else if (typed_cmd == no_arg_command::FULLSCREEN_QUAD) {
+							++stats.drawcalls;
+							stats.triangles += 2;
+							stats.uploaded_bytes += sizeof(float) * 12;
+						}
+					}
+					else if constexpr(std::is_same_v<C, object_command<texture, texImage2D_command>>) {
+						const auto size = typed_cmd.payload.source.get_size();
+						stats.uploaded_bytes += std::size_t(size.x) * size.y * sizeof(rgba);
+					}
+				};
+
+				std::visit(command_handler, c[i].payload);
+			}
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("NullRendererBackend AccountsForCommands") {
+	using namespace augs;
+	using namespace augs::graphics;
+
+	dedicated_buffers dedicated;
+	dedicated[dedicated_buffer::GROUND].triangles.resize(5);
+	dedicated[dedicated_buffer::GROUND].specials.resize(15);
+	dedicated[dedicated_buffer::FOREGROUND].lines.resize(3);
+
+	vertex_triangle_buffer custom;
+	custom.resize(7);
+
+	std::vector<renderer_command> commands;
+
+	commands.push_back({ drawcall_dedicated_command { dedicated_buffer::GROUND } });
+	commands.push_back({ drawcall_dedicated_command { dedicated_buffer::FOREGROUND } });
+	commands.push_back({ drawcall_dedicated_command { dedicated_buffer::THUNDERS } });
+	commands.push_back({ drawcall_custom_buffer_command { custom } });
+	commands.push_back({ no_arg_command::SET_ADDITIVE_BLENDING });
+
+	null_renderer_backend backend;
+	renderer_backend_result result;
+
+	backend.perform(result, commands.data(), commands.size(), dedicated);
+
+	const auto& stats = backend.get_stats();
+
+	REQUIRE(stats.commands == 5);
+	REQUIRE(stats.drawcalls == 3);
+	REQUIRE(stats.triangles == 12);
+	REQUIRE(stats.lines == 3);
+	REQUIRE(stats.uploaded_bytes == 12 * sizeof(vertex_triangle) + 3 * sizeof(vertex_line) + 15 * sizeof(special));
+	REQUIRE(result.imgui_lists_to_delete.empty());
+}
+#endif
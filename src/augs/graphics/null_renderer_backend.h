@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "augs/graphics/renderer_backend.h"
+
+namespace augs {
+	namespace graphics {
+		struct renderer_backend_stats {
+			std::size_t commands = 0;
+			std::size_t drawcalls = 0;
+			std::size_t triangles = 0;
+			std::size_t lines = 0;
+			std::size_t uploaded_bytes = 0;
+
+			void clear() {
+				*this = {};
+			}
+
+			std::string summary() const;
+		};
+
+		/*
+			Consumes the same command stream as renderer_backend but issues no calls to the GPU.
+			It only accounts for what would be drawn and uploaded,
+			so that everything that builds the commands can be profiled in isolation.
+
+			Object commands like texture uploads or shader uniforms are skipped,
+			so the objects they point to are never dereferenced.
+		*/
+
+		class null_renderer_backend {
+			renderer_backend_stats stats;
+
+		public:
+			void perform(
+				renderer_backend_result& output,
+				const renderer_command*,
+				std::size_t n,
+				const dedicated_buffers&
+			);
+
+			const auto& get_stats() const {
+				return stats;
+			}
+
+			void clear_stats() {
+				stats.clear();
+			}
+		};
+	}
+}
@@ -19,6 +19,10 @@ namespace augs {
 		T last_maximum = T();
 		T last_measurement = T();
 
+		/* Over the entire lifetime, unlike the tracked window. */
+		T total = T();
+		std::size_t num_measurements = 0;
+
 		bool measured = false;
 
 		struct summary_data {
@@ -47,6 +51,9 @@ namespace augs {
 			measured = true;
 			last_measurement = value;
 
+			total += value;
+			++num_measurements;
+
 			tracked[measurement_index] = last_measurement;
 			++measurement_index;
 			measurement_index %= tracked.size();
@@ -87,6 +94,14 @@ namespace augs {
 			return last_measurement;
 		}
 
+		T get_total_units() const {
+			return total;
+		}
+
+		std::size_t get_num_measurements() const {
+			return num_measurements;
+		}
+
 		bool was_measured() const {
 			return summary_info.measured;
 		}
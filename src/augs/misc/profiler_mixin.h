@@ -86,5 +86,42 @@ namespace augs {
 	
 			output += amounts_summary;
 		}
+
+		/* Accumulated over the entire lifetime, for offline benchmarks. */
+
+		void totals_summary(std::string& output) const {
+			thread_local std::vector<const time_measurements*> all_with_time;
+
+			all_with_time.clear();
+
+			auto& self = *static_cast<const derived*>(this);
+
+			for_each_measurement(
+				[&](auto, const auto& m) {
+					using T = remove_cref<decltype(m)>;
+
+					if constexpr(std::is_same_v<T, time_measurements>) {
+						if (m.get_num_measurements() > 0) {
+							all_with_time.push_back(&m);
+						}
+					}
+				}, 
+				self
+			);
+
+			sort_range(
+				all_with_time, 
+				[](const auto* a, const auto* b) {
+					return a->get_total_units() > b->get_total_units();
+				}
+			);
+
+			for (const auto& t : all_with_time) {
+				const auto n = t->get_num_measurements();
+				const auto total_ms = t->get_total_units() * 1000;
+
+				output += typesafe_sprintf("%x: %f2 ms total, %f2 ms mean over %x\n", t->title, total_ms, total_ms / n, n);
+			}
+		}
 	};
 }
\ No newline at end of file
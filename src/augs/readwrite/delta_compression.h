@@ -84,6 +84,32 @@ namespace augs {
 			return changed_bytes.size() > 0;
 		}
 
+		/* Use this to validate a delta that was read from an untrusted source before decoding it. */
+
+		bool fits_in_object() const {
+			if (changed_offsets.size() % 2 != 0) {
+				return false;
+			}
+
+			std::size_t end_pos = 0;
+			std::size_t consumed_bytes = 0;
+
+			for (std::size_t i = 0; i < changed_offsets.size(); i += 2) {
+				end_pos += changed_offsets[i] + changed_offsets[i + 1];
+				consumed_bytes += changed_offsets[i + 1];
+			}
+
+			return end_pos <= length_bytes && consumed_bytes <= changed_bytes.size();
+		}
+
+		std::size_t get_written_size() const {
+			return 
+				2 * sizeof(offset_type) 
+				+ changed_bytes.size() * sizeof(delta_unit) 
+				+ changed_offsets.size() * sizeof(offset_type)
+			;
+		}
+
 		template <class A>
 		bool write(
 			A& out,
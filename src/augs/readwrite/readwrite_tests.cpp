@@ -10,6 +10,8 @@
 
 #include "augs/string/string_templates.h"
 #include "augs/readwrite/readwrite_test_cycle.h"
+#include "augs/readwrite/delta_compression.h"
+#include "augs/readwrite/memory_stream.h"
 
 #include "augs/math/vec2.h"
 #include "augs/math/transform.h"
@@ -125,6 +127,47 @@ TEST_CASE("Byte readwrite Classes") {
 	readwrite_test_cycle(v);
 }
 
+TEST_CASE("Byte readwrite Object delta") {
+	using T = std::array<uint8_t, 300>;
+
+	T base{};
+	T encoded = base;
+
+	encoded[0] = 1;
+	encoded[1] = 2;
+	encoded[150] = 3;
+	encoded[299] = 4;
+
+	const auto delta = augs::object_delta<T>(base, encoded);
+
+	REQUIRE(delta.has_changed());
+	REQUIRE(delta.fits_in_object());
+
+	augs::memory_stream s;
+	delta.write(s);
+
+	REQUIRE(s.get_write_pos() == delta.get_written_size());
+
+	const auto read_delta = augs::object_delta<T>(s);
+	REQUIRE(read_delta.fits_in_object());
+
+	T decoded = base;
+	read_delta.decode_into(decoded);
+
+	REQUIRE(decoded == encoded);
+
+	{
+		/* A delta whose offsets point past the object must be rejected. */
+
+		augs::memory_stream tampered;
+
+		augs::write_container_bytes(tampered, std::vector<std::byte>(1), uint16_t());
+		augs::write_container_bytes(tampered, std::vector<uint16_t> { 300, 1 }, uint16_t());
+
+		REQUIRE(!augs::object_delta<T>(tampered).fits_in_object());
+	}
+}
+
 TEST_CASE("Byte readwrite Arrays") {
 	/* 
 		Due to default initialization,
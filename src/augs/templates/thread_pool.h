@@ -1,10 +1,14 @@
 #pragma once
 #include <vector>
 #include <thread>
+#include <algorithm>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
-#include <functional>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <type_traits>
 
 namespace augs {
 #if WEB_SINGLETHREAD
@@ -30,15 +34,187 @@ namespace augs {
 		void wait_for_all_tasks_to_complete() {}
 	};
 #else
+	/*
+		Type-erased callable with inline storage,
+		so that typical jobs (a few references and a request struct) do not allocate.
+	*/
+
+	class pool_task {
+		static constexpr std::size_t inline_capacity = 128;
+
+		struct operations {
+			void (*invoke)(void*);
+			void (*relocate)(void* from, void* to);
+			void (*destroy)(void*);
+		};
+
+		template <class F>
+		static constexpr bool fits_inline_v =
+			sizeof(F) <= inline_capacity
+			&& alignof(F) <= alignof(std::max_align_t)
+			&& std::is_nothrow_move_constructible_v<F>
+		;
+
+		template <class F>
+		static const operations* get_operations() {
+			if constexpr(fits_inline_v<F>) {
+				static const operations ops = {
+					[](void* p) { (*reinterpret_cast<F*>(p))(); },
+					[](void* from, void* to) {
+						auto& f = *reinterpret_cast<F*>(from);
+						new (to) F(std::move(f));
+						f.~F();
+					},
+					[](void* p) { reinterpret_cast<F*>(p)->~F(); }
+				};
+
+				return &ops;
+			}
+			else {
+				static const operations ops = {
+					[](void* p) { (**reinterpret_cast<F**>(p))(); },
+					[](void* from, void* to) { new (to) F*(*reinterpret_cast<F**>(from)); },
+					[](void* p) { delete *reinterpret_cast<F**>(p); }
+				};
+
+				return &ops;
+			}
+		}
+
+		alignas(std::max_align_t) std::byte storage[inline_capacity];
+		const operations* ops = nullptr;
+
+		void reset() {
+			if (ops != nullptr) {
+				ops->destroy(storage);
+				ops = nullptr;
+			}
+		}
+
+	public:
+		pool_task() = default;
+
+		template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, pool_task>>>
+		pool_task(F&& f) {
+			using T = std::decay_t<F>;
+
+			if constexpr(fits_inline_v<T>) {
+				new (storage) T(std::forward<F>(f));
+			}
+			else {
+				new (storage) T*(new T(std::forward<F>(f)));
+			}
+
+			ops = get_operations<T>();
+		}
+
+		pool_task(pool_task&& b) noexcept : ops(b.ops) {
+			if (ops != nullptr) {
+				ops->relocate(b.storage, storage);
+				b.ops = nullptr;
+			}
+		}
+
+		pool_task& operator=(pool_task&& b) noexcept {
+			if (this != &b) {
+				reset();
+
+				ops = b.ops;
+
+				if (ops != nullptr) {
+					ops->relocate(b.storage, storage);
+					b.ops = nullptr;
+				}
+			}
+
+			return *this;
+		}
+
+		pool_task(const pool_task&) = delete;
+		pool_task& operator=(const pool_task&) = delete;
+
+		~pool_task() {
+			reset();
+		}
+
+		void operator()() {
+			ops->invoke(storage);
+		}
+	};
+
+	/*
+		Work-stealing pool.
+
+		Every worker owns a queue: it pops its own work from the back
+		and steals from the front of the other queues once it runs dry.
+		Threads that only help (e.g. the main thread) steal from all queues.
+	*/
+
 	class thread_pool {
+		struct worker_queue {
+			std::mutex lock;
+			std::vector<pool_task> tasks;
+			std::size_t front = 0;
+
+			void push(pool_task&& t) {
+				tasks.emplace_back(std::move(t));
+			}
+
+			bool pop_back(pool_task& out) {
+				std::scoped_lock lk(lock);
+
+				if (front == tasks.size()) {
+					return false;
+				}
+
+				out = std::move(tasks.back());
+				tasks.pop_back();
+
+				if (front == tasks.size()) {
+					tasks.clear();
+					front = 0;
+				}
+
+				return true;
+			}
+
+			bool steal_front(pool_task& out) {
+				std::scoped_lock lk(lock);
+
+				if (front == tasks.size()) {
+					return false;
+				}
+
+				out = std::move(tasks[front++]);
+
+				if (front == tasks.size()) {
+					tasks.clear();
+					front = 0;
+				}
+
+				return true;
+			}
+		};
+
+		struct current_worker_info {
+			const thread_pool* pool = nullptr;
+			std::size_t index = 0;
+		};
+
+		static current_worker_info& current_worker() {
+			thread_local current_worker_info info;
+			return info;
+		}
+
 		std::vector<std::thread> workers;
-		std::vector<std::function<void()>> tasks;
-		std::vector<std::function<void()>> cold_tasks;
+		std::vector<std::unique_ptr<worker_queue>> queues;
+		std::vector<pool_task> cold_tasks;
 
-		int tasks_completed = 0;
-		int tasks_posted = 0;
+		std::atomic<int> num_queued = 0;
+		std::atomic<int> num_pending = 0;
+		std::atomic<std::size_t> next_queue = 0;
 
-		std::mutex queue_mutex;
+		std::mutex sleep_mutex;
 		std::condition_variable cv;
 
 		std::condition_variable completion_variable;
@@ -46,48 +222,85 @@ namespace augs {
 
 		std::atomic<bool> shall_quit = false;
 
-		auto lock_queue() {
-			return std::unique_lock<std::mutex>(queue_mutex);
-		}
+		void wake_workers() {
+			{
+				/* Ensures no worker misses the notification between checking and sleeping. */
+				std::scoped_lock lk(sleep_mutex);
+			}
 
-		auto lock_completion() {
-			return std::unique_lock<std::mutex>(completion_mutex);
+			cv.notify_all();
 		}
 
 		void register_completion() {
-			bool completed = false;
+			if (num_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				{
+					std::scoped_lock lk(completion_mutex);
+				}
 
-			{
-				auto lock = lock_completion();
-				++tasks_completed;
+				completion_variable.notify_all();
+			}
+		}
 
-				completed = tasks_completed == tasks_posted;
+		bool try_take(const std::size_t first, const bool own, pool_task& out) {
+			const auto n = queues.size();
+
+			if (own && queues[first]->pop_back(out)) {
+				num_queued.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
 			}
 
-			if (completed) {
-				completion_variable.notify_all();
+			for (std::size_t i = own ? 1 : 0; i < n; ++i) {
+				if (queues[(first + i) % n]->steal_front(out)) {
+					num_queued.fetch_sub(1, std::memory_order_acq_rel);
+					return true;
+				}
 			}
+
+			return false;
 		}
 
-		auto make_continuous_worker() {
-			return [this] {
-				for (;;) {
-					std::function<void()> task;
+		bool try_run_one(const std::size_t first, const bool own) {
+			{
+				pool_task task;
+
+				if (!try_take(first, own, task)) {
+					return false;
+				}
 
-					{
-						auto lock = lock_queue();
-						cv.wait(lock, [this]{ return shall_quit || !tasks.empty(); });
+				task();
+			}
+
+			register_completion();
+			return true;
+		}
+
+		bool help_once() {
+			const auto& info = current_worker();
+
+			if (info.pool == this) {
+				return try_run_one(info.index, true);
+			}
+
+			return try_run_one(next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size(), false);
+		}
 
-						if (shall_quit.load() && tasks.empty()) {
-							return;
-						}
+		auto make_continuous_worker(const std::size_t index) {
+			return [this, index] {
+				auto& info = current_worker();
+				info.pool = this;
+				info.index = index;
 
-						task = std::move(tasks.back());
-						tasks.pop_back();
+				for (;;) {
+					if (try_run_one(index, true)) {
+						continue;
 					}
 
-					task();
-					register_completion();
+					std::unique_lock<std::mutex> lk(sleep_mutex);
+					cv.wait(lk, [this]{ return shall_quit.load() || num_queued.load() > 0; });
+
+					if (shall_quit.load() && num_queued.load() == 0) {
+						return;
+					}
 				}
 			};
 		}
@@ -104,7 +317,7 @@ namespace augs {
 			}
 
 			shall_quit.store(true);
-			cv.notify_all();
+			wake_workers();
 			join_all();
 			workers.clear();
 		}
@@ -122,32 +335,69 @@ namespace augs {
 			quit_all_workers();
 			shall_quit.store(false);
 
+			/*
+				Even without workers, there is a queue for the helping threads to drain.
+				Leftover work is carried over to the new queues.
+			*/
+
+			std::vector<pool_task> leftovers;
+
+			for (auto& q : queues) {
+				for (std::size_t i = q->front; i < q->tasks.size(); ++i) {
+					leftovers.emplace_back(std::move(q->tasks[i]));
+				}
+			}
+
+			queues.clear();
+
+			for (std::size_t i = 0; i < std::max(num_workers, std::size_t(1)); ++i) {
+				queues.emplace_back(std::make_unique<worker_queue>());
+			}
+
+			for (auto& t : leftovers) {
+				queues[0]->push(std::move(t));
+			}
+
 			for (std::size_t i = 0; i < num_workers; ++i) {
-				workers.emplace_back(make_continuous_worker());
+				workers.emplace_back(make_continuous_worker(i));
 			}
 		}
 
+		/* Stores the task until the next submit. */
+
 		template <class F>
 		void enqueue(F&& f) {
-			cold_tasks.emplace_back(std::move(f));
+			cold_tasks.emplace_back(std::forward<F>(f));
 		}
 
+		/* Distributes all enqueued tasks evenly between the worker queues. */
+
 		void submit() {
-			{
-				auto lock = lock_queue();
-				ensure(tasks.empty());
-				std::swap(cold_tasks, tasks);
+			if (cold_tasks.empty()) {
+				return;
+			}
 
-				{
-					auto lock = lock_completion();
-					tasks_completed = 0;
-					tasks_posted = tasks.size();
+			const auto n = queues.size();
+			const auto first = next_queue.fetch_add(1, std::memory_order_relaxed);
+
+			num_pending.fetch_add(static_cast<int>(cold_tasks.size()), std::memory_order_acq_rel);
+
+			for (std::size_t qi = 0; qi < n; ++qi) {
+				auto& q = *queues[(first + qi) % n];
+				int pushed = 0;
+
+				std::scoped_lock lk(q.lock);
+
+				for (std::size_t i = qi; i < cold_tasks.size(); i += n) {
+					q.push(std::move(cold_tasks[i]));
+					++pushed;
 				}
+
+				num_queued.fetch_add(pushed, std::memory_order_acq_rel);
 			}
 
 			cold_tasks.clear();
-			completion_variable.notify_all();
-			cv.notify_all();
+			wake_workers();
 		}
 
 		std::size_t size() const {
@@ -155,30 +405,13 @@ namespace augs {
 		}
 
 		void help_until_no_tasks() {
-			for (;;) {
-				std::function<void()> task;
-
-				{
-					auto lock = lock_queue();
-
-					if (tasks.empty()) {
-						return;
-					}
-
-					task = std::move(tasks.back());
-					tasks.pop_back();
-				}
-
-				task();
-				register_completion();
-			}
+			while (help_once()) {}
 		}
 
 		void wait_for_all_tasks_to_complete() {
-			auto lock = lock_completion();
-			completion_variable.wait(lock, [this]{ return tasks_posted == tasks_completed; });
+			std::unique_lock<std::mutex> lk(completion_mutex);
+			completion_variable.wait(lk, [this]{ return num_pending.load() == 0; });
 		}
 	};
 #endif
 }
-
@@ -21,6 +21,10 @@ struct atlas_profiler : public augs::profiler_mixin<atlas_profiler> {
 	augs::time_measurements blitting_images = std::size_t(1);
 	augs::time_measurements blitting_fonts = std::size_t(1);
 
+	augs::time_measurements hashing_images = std::size_t(1);
+	augs::time_measurements copying_previous_atlas = std::size_t(1);
+	augs::amount_measurements<std::size_t> reused_subjects_count = std::size_t(1);
+
 	augs::amount_measurements<vec2u> atlas_size = std::size_t(1);
 	augs::amount_measurements<unsigned> atlas_height = std::size_t(1);
 	augs::time_measurements resizing_image = std::size_t(1);
@@ -1,6 +1,7 @@
 #include <string>
 #include <sstream>
 #include <numeric>
+#include <algorithm>
 
 #include "3rdparty/rectpack2D/src/finders_interface.h"
 
@@ -26,6 +27,166 @@
 
 using namespace rectpack2D;
 
+constexpr bool allow_flip = true;
+using spaces_type = rectpack2D::empty_spaces<allow_flip>;
+
+static rect_xywhf to_packer_rect(const atlas_packing_cache::packed_rect& r) {
+	return rect_xywhf(r.x, r.y, r.w, r.h, r.flipped);
+}
+
+static atlas_packing_cache::packed_rect to_cached_rect(const rect_xywhf& r, const vec2u original_size) {
+	atlas_packing_cache::packed_rect result;
+
+	result.original_size = original_size;
+	result.x = r.x;
+	result.y = r.y;
+	result.w = r.w;
+	result.h = r.h;
+	result.flipped = r.flipped;
+
+	return result;
+}
+
+/*
+	Writes the final rectangles into rects only if the whole incremental pack succeeds,
+	so that a failed attempt leaves the input intact for a full repack.
+*/
+
+static bool pack_incrementally(
+	const atlas_packing_cache& cache,
+	const atlas_input_subjects& subjects,
+	const std::vector<augs::secure_hash_type>& hashes,
+	std::vector<rect_xywhf>& rects,
+	std::vector<bool>& already_in_atlas,
+	const int max_size,
+	const int rect_padding_amount,
+	vec2u& output_size
+) {
+	if (cache.atlas_size.is_zero() || cache.pixels.size() != cache.atlas_size.area() || cache.fonts != subjects.fonts) {
+		return false;
+	}
+
+	const auto images_n = subjects.count_images();
+
+	if (rects.size() - images_n != cache.glyphs.size()) {
+		return false;
+	}
+
+	thread_local std::vector<rect_xywhf> candidate;
+	thread_local std::vector<std::size_t> new_indices;
+	thread_local std::vector<rect_xywhf> new_rects;
+
+	candidate = rects;
+	new_indices.clear();
+	new_rects.clear();
+
+	for (std::size_t i = 0; i < images_n; ++i) {
+		const auto& r = candidate[i];
+
+		if (r.w == 0 || r.h == 0) {
+			/* Failed to load, will get the glitch uv anyway. */
+			continue;
+		}
+
+		const auto found = mapped_or_nullptr(cache.images, hashes[i]);
+
+		if (found != nullptr && found->original_size == vec2u(r.w, r.h)) {
+			candidate[i] = to_packer_rect(*found);
+		}
+		else {
+			new_indices.push_back(i);
+			new_rects.push_back(rect_xywh(0, 0, r.w + rect_padding_amount, r.h + rect_padding_amount));
+		}
+	}
+
+	for (std::size_t g = 0; g < cache.glyphs.size(); ++g) {
+		candidate[images_n + g] = to_packer_rect(cache.glyphs[g]);
+	}
+
+	auto new_size = vec2i(cache.atlas_size);
+
+	if (new_rects.size() > 0) {
+		bool all_fit = true;
+
+		const auto block = find_best_packing<spaces_type>(
+			new_rects,
+			make_finder_input(
+				max_size,
+				1,
+				[](auto){ return rectpack2D::callback_result::CONTINUE_PACKING; },
+				[&all_fit](const auto&){ all_fit = false; return rectpack2D::callback_result::ABORT_PACKING; },
+				flipping_option::ENABLED
+			)
+		);
+
+		if (!all_fit) {
+			return false;
+		}
+
+		const auto old_size = new_size;
+
+		const auto to_the_right = vec2i(old_size.x + block.w, std::max(old_size.y, block.h));
+		const auto below = vec2i(std::max(old_size.x, block.w), old_size.y + block.h);
+
+		auto fits = [max_size](const vec2i s) {
+			return s.x <= max_size && s.y <= max_size;
+		};
+
+		auto area = [](const vec2i s) {
+			return std::size_t(s.x) * s.y;
+		};
+
+		vec2i block_origin;
+
+		if (fits(to_the_right) && (!fits(below) || area(to_the_right) <= area(below))) {
+			block_origin = vec2i(old_size.x, 0);
+			new_size = to_the_right;
+		}
+		else if (fits(below)) {
+			block_origin = vec2i(0, old_size.y);
+			new_size = below;
+		}
+		else {
+			return false;
+		}
+
+		for (std::size_t k = 0; k < new_rects.size(); ++k) {
+			auto r = new_rects[k];
+
+			r.x += block_origin.x;
+			r.y += block_origin.y;
+			r.w -= rect_padding_amount;
+			r.h -= rect_padding_amount;
+
+			candidate[new_indices[k]] = r;
+		}
+	}
+
+	std::size_t used_space = 0;
+
+	for (const auto& r : candidate) {
+		if (r.w > 0 && r.h > 0) {
+			used_space += std::size_t(r.w + rect_padding_amount) * (r.h + rect_padding_amount);
+		}
+	}
+
+	const auto total_space = std::size_t(new_size.x) * new_size.y;
+
+	if (double(used_space) < total_space * (1.0 - atlas_packing_cache::max_wasted_fraction)) {
+		return false;
+	}
+
+	rects = candidate;
+	already_in_atlas.assign(rects.size(), true);
+
+	for (const auto i : new_indices) {
+		already_in_atlas[i] = false;
+	}
+
+	output_size = vec2u(new_size);
+	return true;
+}
+
 void bake_fresh_atlas(
 	const bake_fresh_atlas_input in,
 	const bake_fresh_atlas_output out
@@ -52,6 +213,45 @@ void bake_fresh_atlas(
 		return sz.any_zero() || sz.x > ms || sz.y > ms;
 	};
 
+	thread_local std::vector<std::vector<std::byte>> all_loaded_bytes;
+
+	{
+		auto scope = measure_scope(out.profiler.loading_images);
+
+		const auto images_n = subjects.images.size();
+
+		if (images_n > all_loaded_bytes.size()) {
+			all_loaded_bytes.resize(images_n);
+		}
+
+		for (const auto& input_img_id : subjects.images) {
+			const auto current_rect = index_in(subjects.images, input_img_id);
+
+			try {
+				all_loaded_bytes[current_rect].clear();
+				augs::file_to_bytes(input_img_id, all_loaded_bytes[current_rect]);
+			}
+			catch (...) {
+
+			}
+		}
+	}
+
+	thread_local std::vector<augs::secure_hash_type> image_hashes;
+	image_hashes.clear();
+
+	if (in.cache != nullptr) {
+		auto scope = measure_scope(out.profiler.hashing_images);
+
+		for (std::size_t i = 0; i < subjects.images.size(); ++i) {
+			image_hashes.push_back(augs::secure_hash(all_loaded_bytes[i]));
+		}
+
+		for (const auto& input_image_bytes : subjects.loaded_images) {
+			image_hashes.push_back(augs::secure_hash(input_image_bytes));
+		}
+	}
+
 	{
 		auto scope = measure_scope_additive(out.profiler.loading_image_sizes);
 
@@ -152,6 +352,11 @@ void bake_fresh_atlas(
 		}
 	}
 
+	thread_local std::vector<bool> already_in_atlas;
+	already_in_atlas.assign(rects_for_packer.size(), false);
+
+	bool packed_incrementally = false;
+
 	{
 		auto scope = measure_scope(out.profiler.packing);
 
@@ -160,39 +365,58 @@ void bake_fresh_atlas(
 
 		out.profiler.subjects_count.measure(rects_for_packer.size());
 
-		for (auto& rr : rects_for_packer) {
-			rr.w += rect_padding_amount;
-			rr.h += rect_padding_amount;
+		if (in.cache != nullptr) {
+			packed_incrementally = pack_incrementally(
+				*in.cache,
+				subjects,
+				image_hashes,
+				rects_for_packer,
+				already_in_atlas,
+				max_size,
+				rect_padding_amount,
+				output_image_size
+			);
 		}
 
-		constexpr bool allow_flip = true;
+		if (!packed_incrementally) {
+			for (auto& rr : rects_for_packer) {
+				rr.w += rect_padding_amount;
+				rr.h += rect_padding_amount;
+			}
 
-		using spaces_type = rectpack2D::empty_spaces<allow_flip>;
+			const auto result_size = find_best_packing<spaces_type>(
+				rects_for_packer,
+				make_finder_input(
+					max_size,
+					1,
+					[](auto){ return rectpack2D::callback_result::CONTINUE_PACKING; },
+					[](const auto& r){ LOG("ERROR: (%x;%x;%x;%x) didn't fit into atlas.", r.x, r.y, r.w, r.h); return rectpack2D::callback_result::ABORT_PACKING; },
+					flipping_option::ENABLED
+				)
+			);
 
-		const auto result_size = find_best_packing<spaces_type>(
-			rects_for_packer,
-			make_finder_input(
-				max_size,
-				1,
-				[](auto){ return rectpack2D::callback_result::CONTINUE_PACKING; },
-				[](const auto& r){ LOG("ERROR: (%x;%x;%x;%x) didn't fit into atlas.", r.x, r.y, r.w, r.h); return rectpack2D::callback_result::ABORT_PACKING; },
-				flipping_option::ENABLED
-			)
-		);
+			output_image_size = vec2u(result_size.w, result_size.h);
 
-		output_image_size = vec2u(result_size.w, result_size.h);
+			for (auto& rr : rects_for_packer) {
+				rr.w -= rect_padding_amount;
+				rr.h -= rect_padding_amount;
+			}
+		}
 
 		std::size_t total_used_space = 0;
+		std::size_t reused_count = 0;
 
 		for (auto& rr : rects_for_packer) {
-			total_used_space += rr.area();
+			if (rr.w > 0 && rr.h > 0) {
+				total_used_space += std::size_t(rr.w + rect_padding_amount) * (rr.h + rect_padding_amount);
+			}
 		}
 
-		for (auto& rr : rects_for_packer) {
-			rr.w -= rect_padding_amount;
-			rr.h -= rect_padding_amount;
+		for (const bool reused : already_in_atlas) {
+			reused_count += reused ? 1 : 0;
 		}
 
+		out.profiler.reused_subjects_count.measure(reused_count);
 		out.profiler.atlas_size.measure(output_image_size);
 		const auto wasted_space = output_image_size.area() - total_used_space;
 		out.profiler.wasted_space.measure(wasted_space);
@@ -217,31 +441,27 @@ void bake_fresh_atlas(
 	output_image.fill({0, 0, 0, 255});
 #endif
 
-	{
-		thread_local std::vector<std::vector<std::byte>> all_loaded_bytes;
+	if (packed_incrementally) {
+		auto scope = measure_scope(out.profiler.copying_previous_atlas);
 
-		{
-			auto scope = measure_scope(out.profiler.loading_images);
+		/* 
+			Reused rectangles kept their positions and the previous atlas lies in the top-left corner,
+			so copying it carries over every reused image with its border.
+		*/
 
-			const auto images_n = subjects.images.size();
-
-				if (images_n > all_loaded_bytes.size()) {
-					all_loaded_bytes.resize(images_n);
-				}
-
-			for (const auto& input_img_id : subjects.images) {
-				const auto current_rect = index_in(subjects.images, input_img_id);
-
-				try {
-					all_loaded_bytes[current_rect].clear();
-					augs::file_to_bytes(input_img_id, all_loaded_bytes[current_rect]);
-				}
-				catch (...) {
+		const auto& cache = *in.cache;
+		const auto previous_width = cache.atlas_size.x;
 
-				}
-			}
+		for (unsigned y = 0; y < cache.atlas_size.y; ++y) {
+			std::copy_n(
+				cache.pixels.data() + std::size_t(y) * previous_width,
+				previous_width,
+				std::addressof(output_image.pixel(vec2u(0, y)))
+			);
 		}
+	}
 
+	{
 		struct worker_input {
 			unsigned image_area;
 			unsigned original_index;
@@ -327,6 +547,11 @@ void bake_fresh_atlas(
 			output_entry.was_flipped = packed_rect.flipped;
 			output_entry.was_successfully_packed = true;
 
+			if (already_in_atlas[current_rect]) {
+				/* Already copied from the previous atlas. */
+				return;
+			}
+
 			thread_local augs::image loaded_image;
 
 			const auto& source_bytes = 
@@ -380,7 +605,7 @@ void bake_fresh_atlas(
 	{
 		auto scope = measure_scope(out.profiler.blitting_fonts);
 
-		std::size_t current_rect = subjects.images.size();
+		std::size_t current_rect = subjects.count_images();
 
 		for (auto& input_font_id : subjects.fonts) {
 			if (found_in(fonts_to_skip, std::addressof(input_font_id))) {
@@ -419,7 +644,146 @@ void bake_fresh_atlas(
 		}
 	}
 
+	if (in.cache != nullptr) {
+		auto& cache = *in.cache;
+
+		cache.atlas_size = output_image_size;
+		const auto first_pixel = std::addressof(output_image.pixel(vec2u(0, 0)));
+		cache.pixels.assign(first_pixel, first_pixel + output_image_size.area());
+
+		cache.images.clear();
+
+		for (std::size_t i = 0; i < subjects.count_images(); ++i) {
+			const auto& entry = 
+				i < subjects.images.size() ? 
+				baked.images[subjects.images[i]] : 
+				baked.loaded_images[i - subjects.images.size()]
+			;
+
+			if (entry.was_successfully_packed) {
+				cache.images[image_hashes[i]] = to_cached_rect(rects_for_packer[i], entry.cached_original_size_pixels);
+			}
+		}
+
+		cache.fonts = subjects.fonts;
+		cache.glyphs.clear();
+
+		for (std::size_t i = subjects.count_images(); i < rects_for_packer.size(); ++i) {
+			const auto& r = rects_for_packer[i];
+			cache.glyphs.push_back(to_cached_rect(r, vec2u(r.w, r.h)));
+		}
+	}
+
 #if TEST_SAVE_ATLAS
 	augs::image(output_image.data(), output_image.get_size()).save_as_image("/tmp/atl.image");
 #endif
-}
\ No newline at end of file
+}
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("AtlasBaking IncrementalMatchesFull") {
+	auto make_image_bytes = [](const vec2u size, const unsigned seed) {
+		augs::image img(size);
+
+		for (unsigned y = 0; y < size.y; ++y) {
+			for (unsigned x = 0; x < size.x; ++x) {
+				img.pixel(vec2u(x, y)) = rgba(
+					static_cast<rgba_channel>(x * 7 + seed),
+					static_cast<rgba_channel>(y * 13 + seed),
+					static_cast<rgba_channel>(seed * 31),
+					255
+				);
+			}
+		}
+
+		return img.to_image_bytes();
+	};
+
+	struct bake_result {
+		baked_atlas baked;
+		std::vector<rgba> pixels;
+	};
+
+	auto bake = [](const atlas_input_subjects& subjects, atlas_packing_cache* const cache) {
+		bake_result result;
+		atlas_profiler profiler;
+
+		bake_fresh_atlas(
+			{ subjects, 2048, 1, cache },
+			{ nullptr, result.pixels, result.baked, profiler }
+		);
+
+		return result;
+	};
+
+	auto read_back = [](const bake_result& r, const augs::atlas_entry& entry) {
+		const auto atlas_size = r.baked.atlas_image_size;
+		const auto size = entry.get_original_size();
+
+		const auto origin = vec2u(
+			static_cast<unsigned>(entry.atlas_space.x * atlas_size.x + 0.5f),
+			static_cast<unsigned>(entry.atlas_space.y * atlas_size.y + 0.5f)
+		);
+
+		std::vector<rgba> result;
+
+		for (unsigned y = 0; y < size.y; ++y) {
+			for (unsigned x = 0; x < size.x; ++x) {
+				const auto p = entry.was_flipped ? origin + vec2u(y, x) : origin + vec2u(x, y);
+				result.push_back(r.pixels[p.y * atlas_size.x + p.x]);
+			}
+		}
+
+		return result;
+	};
+
+	atlas_input_subjects subjects;
+
+	for (unsigned i = 0; i < 12; ++i) {
+		subjects.loaded_images.push_back(make_image_bytes(vec2u(8 + i * 5, 40 - i * 3), i));
+	}
+
+	atlas_packing_cache cache;
+
+	const auto cold = bake(subjects, &cache);
+	const auto warm = bake(subjects, &cache);
+
+	REQUIRE(warm.baked.atlas_image_size == cold.baked.atlas_image_size);
+	REQUIRE(warm.pixels == cold.pixels);
+
+	for (std::size_t i = 0; i < subjects.loaded_images.size(); ++i) {
+		REQUIRE(warm.baked.loaded_images[i].atlas_space == cold.baked.loaded_images[i].atlas_space);
+		REQUIRE(warm.baked.loaded_images[i].was_flipped == cold.baked.loaded_images[i].was_flipped);
+	}
+
+	subjects.loaded_images.push_back(make_image_bytes(vec2u(24, 17), 100));
+
+	const auto incremental = bake(subjects, &cache);
+	const auto full = bake(subjects, nullptr);
+
+	{
+		/* The previous atlas is carried over as it was. */
+		const auto previous_size = cold.baked.atlas_image_size;
+		const auto new_width = incremental.baked.atlas_image_size.x;
+
+		for (unsigned y = 0; y < previous_size.y; ++y) {
+			for (unsigned x = 0; x < previous_size.x; ++x) {
+				REQUIRE(incremental.pixels[y * new_width + x] == cold.pixels[y * previous_size.x + x]);
+			}
+		}
+	}
+
+	for (std::size_t i = 0; i < subjects.loaded_images.size(); ++i) {
+		const auto& inc_entry = incremental.baked.loaded_images[i];
+		const auto& full_entry = full.baked.loaded_images[i];
+
+		REQUIRE(inc_entry.was_successfully_packed);
+		REQUIRE(full_entry.was_successfully_packed);
+		REQUIRE(read_back(incremental, inc_entry) == read_back(full, full_entry));
+
+		if (i < cold.baked.loaded_images.size()) {
+			REQUIRE(read_back(incremental, inc_entry) == read_back(cold, cold.baked.loaded_images[i]));
+		}
+	}
+}
+#endif
@@ -5,6 +5,7 @@
 #include "augs/filesystem/path.h"
 #include "augs/image/font.h"
 #include "augs/texture_atlas/atlas_profiler.h"
+#include "augs/misc/secure_hash.h"
 
 #include "augs/texture_atlas/loaded_images_vector.h"
 
@@ -41,10 +42,52 @@ struct baked_atlas {
 	}
 };
 
+/*
+	Remembers where every image was packed in the previous bake, together with the pixels of that atlas.
+
+	Images are identified by the hash of their bytes,
+	so the next bake keeps the rectangles of unchanged images and does not pack them again.
+	The previous atlas is copied row by row into the top-left corner of the new one,
+	so unchanged images are neither decoded nor blitted.
+	Only new or modified images are packed, into a block appended to the right of or below the previous atlas.
+
+	A full repack happens when the fonts change,
+	when the new block does not fit,
+	or when too much of the atlas is taken by images that are no longer used.
+*/
+
+struct atlas_packing_cache {
+	struct packed_rect {
+		vec2u original_size;
+
+		int x = 0;
+		int y = 0;
+		int w = 0;
+		int h = 0;
+		bool flipped = false;
+	};
+
+	static constexpr double max_wasted_fraction = 0.5;
+
+	vec2u atlas_size;
+
+	std::unordered_map<augs::secure_hash_type, packed_rect> images;
+
+	std::vector<source_font_identifier> fonts;
+	std::vector<packed_rect> glyphs;
+
+	std::vector<rgba> pixels;
+
+	void clear() {
+		*this = {};
+	}
+};
+
 struct bake_fresh_atlas_input {
 	const atlas_input_subjects& subjects;
 	const unsigned max_atlas_size;
 	const unsigned blitting_threads;
+	atlas_packing_cache* const cache = nullptr;
 };
 
 struct bake_fresh_atlas_output {
@@ -17,7 +17,8 @@ namespace augs {
 	
 	void window::set_fullscreen_hint(const bool) {}
 
-	xywhi window::get_window_rect_impl() const { return {}; }
+	/* Report the configured geometry, so that frames are laid out as on a real screen. */
+	xywhi window::get_window_rect_impl() const { return current_settings.make_window_rect(); }
 	xywhi window::get_display() const { return {}; }
 
 	void window::destroy() {}
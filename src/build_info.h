@@ -102,6 +102,19 @@ Options:
                                 Remember to set --no-router if you're hosting e.g. on a proper VPS without a router.
 	--no-router					Disables NAT traversal for incoming connections. NAT traversal is unnecessary if you forwarded the ports,
                                 plan to only play over LAN or have a proper server instance with a dedicated IP address, without a router.
+    --benchmark-demo [PATH]     Re-simulate the demo at PATH as fast as possible, without a window or audio, then quit.
+                                Prints the time spent in every cosmos system and a trail of solvable hashes.
+    --benchmark-report [PATH]   Used with --benchmark-demo. Also write the report to PATH.
+    --null-renderer             Build all rendering commands as usual, but never send them to the GPU.
+                                Only counts drawcalls, triangles and uploaded bytes. A window and a GL context are still created for the resources,
+                                unless the game was built with HEADLESS_FRAME_BENCHMARK, which implies this flag and needs no display.
+    --benchmark-frames [N]      Quit after N rendered frames, printing the accumulated game thread timings.
+                                Combine with --null-renderer and e.g. --connect demo://PATH to measure the CPU cost of frames.
+    --benchmark-neon-maps       Generate the neon maps of all official images in memory with both the current and the reference algorithm,
+                                print the time spent in each and whether they agree, then quit. Nothing is written to the cache.
+    --benchmark-explosion-queries
+                                Resolve explosion fans in a generated crowded world, once with a broadphase query per triangle
+                                and once with a single batched query per explosion. Print the time spent in each, then quit.
     --daily-autoupdates         Dedicated server only. Set this to apply updates when available, at a given hour every day - 03:00 (AM) by default.
                                 To change the hour, set the server.daily_autoupdate_hour variable in config.json, e.g. to "19:30".
 
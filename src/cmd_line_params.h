@@ -40,6 +40,13 @@ struct cmd_line_params {
 	augs::path_type assign_teams;
 
 	int test_fp_consistency = -1;
+	augs::path_type benchmark_demo;
+	augs::path_type benchmark_report;
+
+	bool null_renderer = false;
+	int benchmark_frames = -1;
+	bool benchmark_neon_maps = false;
+	bool benchmark_explosion_queries = false;
 	std::string connect_address;
 
 	bool as_service = false;
@@ -210,6 +217,24 @@ struct cmd_line_params {
 			else if (a == "--test-fp-consistency") {
 				test_fp_consistency = std::atoi(get_next());
 			}
+			else if (a == "--benchmark-demo") {
+				benchmark_demo = get_next();
+			}
+			else if (a == "--benchmark-report") {
+				benchmark_report = get_next();
+			}
+			else if (a == "--null-renderer") {
+				null_renderer = true;
+			}
+			else if (a == "--benchmark-frames") {
+				benchmark_frames = std::atoi(get_next());
+			}
+			else if (a == "--benchmark-neon-maps") {
+				benchmark_neon_maps = true;
+			}
+			else if (a == "--benchmark-explosion-queries") {
+				benchmark_explosion_queries = true;
+			}
 			else if (a == "--nat-punch-port") {
 				first_udp_command_port = std::atoi(get_next());
 			}
@@ -1,9 +1,8 @@
 #pragma once
-#include <compare>
 #include "augs/math/vec2.h"
-#include "game/cosmos/entity_id.h"
-#include "3rdparty/Box2D/Dynamics/b2Filter.h"
+#include "augs/misc/constant_size_vector.h"
 #include "augs/pad_bytes.h"
+#include "game/container_sizes.h"
 
 class pathfinding_system;
 
@@ -16,31 +15,18 @@ struct pathfinding_navigation_hint {
 	// END GEN INTROSPECTOR
 };
 
-struct pathfinding_navigation_vertex {
-	// GEN INTROSPECTOR struct pathfinding_navigation_vertex
-	vec2 location;
-	vec2 sensor;
-	// END GEN INTROSPECTOR
-
-	bool operator==(const pathfinding_navigation_vertex& b) const {
-		return location == b.location && sensor == b.sensor;
-	}
-};
+using pathfinding_waypoints = augs::constant_size_vector<vec2, PATHFINDING_WAYPOINTS_COUNT>;
 
 struct pathfinding_session {
 	// GEN INTROSPECTOR struct pathfinding_session
 	vec2 target;
 	vec2 navigate_to;
 
-	bool persistent_navpoint_set = false;
-	pad_bytes<3> pad;
-	pathfinding_navigation_vertex persistent_navpoint;
-
-	std::vector<pathfinding_navigation_vertex> discovered_vertices;
-	std::vector<pathfinding_navigation_vertex> undiscovered_vertices;
-	std::vector<pathfinding_navigation_vertex> undiscovered_visible;
+	pathfinding_waypoints waypoints;
+	uint32_t next_waypoint = 0;
 
-	float temporary_ignore_discontinuities_shorter_than = 0.f;
+	bool needs_replanning = true;
+	pad_bytes<3> pad;
 	// END GEN INTROSPECTOR
 
 	bool operator==(const pathfinding_session&) const = default;
@@ -48,33 +34,15 @@ struct pathfinding_session {
 
 namespace components {
 	struct pathfinding {
-		static constexpr bool allow_nontriviality = true;
-
-		static void clone_children(cosmos&, pathfinding&, const pathfinding&) { /* no children */ }
-
 		// GEN INTROSPECTOR struct components::pathfinding
-		float target_offset = 0.f;
-		float rotate_navpoints = 0.f;
-		float distance_navpoint_hit = 0.f;
-		float starting_ignore_discontinuities_shorter_than = 100.f;
-
-		b2Filter filter;
-		bool force_persistent_navpoints = false;
-		bool force_touch_sensors = false;
+		float distance_navpoint_hit = 30.f;
 
-		bool enable_session_rollbacks = true;
-		bool mark_touched_as_discovered = false;
+		bool is_pathfinding = false;
 		bool is_exploring = false;
-		bool enable_backtracking = true;
-		
-		bool favor_velocity_parallellness = false;
-		pad_bytes<3> pad;
-
-		vec2 eye_offset;
+		pad_bytes<2> pad;
 
 		pathfinding_navigation_hint custom_exploration_hint;
-
-		std::vector<pathfinding_session> session_stack;
+		pathfinding_session current_session;
 		// END GEN INTROSPECTOR
 
 		pathfinding_session& session();
@@ -88,8 +56,5 @@ namespace components {
 		vec2 get_current_target() const;
 		bool has_pathfinding_finished() const;
 		bool has_exploring_finished() const;
-		bool exists_through_undiscovered_visible(vec2 navpoint, float max_distance) const;
-
-		void reset_persistent_navpoint();
 	};
-}
\ No newline at end of file
+}
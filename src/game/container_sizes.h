@@ -13,6 +13,8 @@ constexpr std::size_t RENDERING_POLYGON_INDEX_COUNT = 20;
 
 constexpr std::size_t OWNER_FRICTION_GROUNDS_COUNT = 10;
 
+constexpr std::size_t PATHFINDING_WAYPOINTS_COUNT = 32;
+
 // TODO: this will be view-bound, not logic-bound
 constexpr std::size_t ONLY_PICK_THESE_ITEMS_COUNT = 20;
 
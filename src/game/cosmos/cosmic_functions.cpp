@@ -14,6 +14,7 @@
 #include "game/inferred_caches/processing_lists_cache.hpp"
 #include "game/inferred_caches/flavour_id_cache.hpp"
 #include "game/inferred_caches/physics_world_cache.hpp"
+#include "game/inferred_caches/navmesh_cache.hpp"
 #include "game/cosmos/just_create_entity_functional.h"
 
 void cosmic::set_flavour_id_cache_enabled(const bool flag, cosmos& cosm) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include "augs/templates/identity_templates.h"
 #include "game/cosmos/entity_flavour_id.h"
 #include "game/cosmos/entity_handle_declaration.h"
@@ -11,6 +12,9 @@
 class cosmic_delta;
 class cosmos;
 
+struct build_arena_input;
+struct editor_node_id;
+
 /*
 	The purpose of this class is to centralize all functions 
 	that can arbitrarily alter the solvable state inside the cosmos,
@@ -33,6 +37,10 @@ class cosmic {
 	template <class F>
 	friend void entity_deleter(const entity_handle, F);
 
+	/* Refreshes edited entities in the editor without recreating them. */
+	template <class A>
+	friend bool rebuild_arena_nodes_in_place(A, build_arena_input, const std::vector<editor_node_id>&);
+
 	template <class E, class C, class I, class P>
 	static ref_typed_entity_handle<E> specific_create_entity_detail(
 		allocate_new_entity_access access,
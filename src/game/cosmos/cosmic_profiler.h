@@ -6,6 +6,7 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 
 	// GEN INTROSPECTOR struct cosmic_profiler
 	augs::time_measurements reinferring_all_entities = 1;
+	augs::time_measurements building_navmesh = 1;
 
 	augs::amount_measurements<std::size_t> visibility_raycasts = 1;
 	augs::amount_measurements<std::size_t> pathfinding_raycasts = 1;
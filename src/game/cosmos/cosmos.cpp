@@ -1,9 +1,9 @@
 #include "augs/ensure_rel.h"
-#include "3rdparty/crc32/crc32.h"
 
 #include "augs/readwrite/memory_stream.h"
 
 #include "augs/misc/randomization.h"
+#include "augs/misc/secure_hash.h"
 
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
@@ -14,6 +14,7 @@
 #include "augs/readwrite/byte_readwrite.h"
 
 #include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/never_changes_in_game.h"
 
 #include <atomic>
 
@@ -56,23 +57,53 @@ cosmos& cosmos::operator=(const cosmos& b) {
 template <class T>
 T cosmos::calculate_solvable_signi_hash() const {
 	if constexpr(std::is_same_v<T, uint32_t>) {
-		augs::memory_stream ss;
+		/*
+			Covers every entity that could possibly diverge between the server and the client,
+			not just the sentiences.
+
+			Components are gathered one by one because they are guaranteed to have no padding,
+			whereas the tuples holding them might.
+		*/
+
+		thread_local augs::memory_stream ss;
+		ss.set_write_pos(0);
 
 		augs::write_bytes(ss, get_clock().now);
 		augs::write_bytes(ss, get_entities_count());
 
-		for_each_having<components::sentience>(
-			[&](const auto& it) {
-				const auto& b = it.template get<components::rigid_body>();
-				const auto& c = b.get_raw_component().physics_transforms.m_xf;
-				const auto& s = it.template get<components::sentience>();
-
-				augs::write_bytes(ss, c);
-				augs::write_bytes(ss, s.meters);
+		get_solvable().significant.for_each_entity_pool(
+			[&](const auto& pool) {
+				using P = remove_cref<decltype(pool)>;
+				using E = entity_type_of<typename P::mapped_type>;
+
+				if constexpr(!never_changes_in_game_v<E>) {
+					const auto& flavours = get_flavours<E>();
+
+					for (const auto& s : pool) {
+						if (flavour_never_changes_in_game(flavours.get(s.flavour_id))) {
+							continue;
+						}
+
+						augs::write_bytes(ss, s.flavour_id);
+						augs::write_bytes(ss, s.when_born);
+
+						for_each_through_std_get(
+							s.component_state,
+							[&](const auto& component) {
+								augs::write_bytes(ss, component);
+							}
+						);
+					}
+				}
 			}
 		);
 
-		return crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos());
+		const auto h = augs::secure_hash(ss.data(), ss.get_write_pos());
+
+		uint32_t result;
+		std::memcpy(&result, h.data(), sizeof(result));
+
+		return result;
 	}
 	else {
 		static_assert(always_false_v<T>, "Unsupported hash type.");
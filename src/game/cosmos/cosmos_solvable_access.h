@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include "game/cosmos/entity_handle_declaration.h"
 #include "game/cosmos/entity_id_declaration.h"
 #include "game/cosmos/handle_getters_declaration.h"
@@ -15,6 +16,9 @@ class resize_nodes_command;
 
 struct debugger_property_accessors;
 
+struct build_arena_input;
+struct editor_node_id;
+
 template <class derived_handle_type>
 struct stored_id_provider;
 
@@ -37,6 +41,9 @@ class cosmos_solvable_access {
 
 	friend debugger_property_accessors;
 
+	template <class A>
+	friend bool rebuild_arena_nodes_in_place(A, build_arena_input, const std::vector<editor_node_id>&);
+
 	template <class C, class E>
 	friend auto subscript_handle_getter(C& cosm, typed_entity_id<E>) 
 		-> id_typed_entity_handle<std::is_const_v<C>, E>
@@ -0,0 +1,61 @@
+#pragma once
+#include "augs/templates/folded_finders.h"
+#include "game/organization/all_entity_types.h"
+#include "game/common_state/entity_flavours.h"
+#include "game/cosmos/entity_pools.h"
+
+/*
+	Entities of these types are only ever created or altered by the editor, never during a round.
+	Both the server and the client already hold them in the clean round state,
+	so they are neither transmitted in arena snapshots nor covered by the state hash.
+*/
+
+template <class E>
+constexpr bool never_changes_in_game_v = is_one_of_v<E,
+	static_decoration,
+	area_marker,
+	particles_decoration,
+	wandering_pixels_decoration,
+	point_marker,
+	static_light,
+	area_sensor
+>;
+
+/* The same, for the entity pool types the solvable is serialized through. False for anything else. */
+
+template <class P, class = void>
+struct is_never_changing_entity_pool : std::false_type {};
+
+template <class P>
+struct is_never_changing_entity_pool<P, std::void_t<typename P::mapped_type::used_entity_type>> : std::bool_constant<
+	std::is_same_v<P, make_entity_pool<typename P::mapped_type::used_entity_type>>
+	&& never_changes_in_game_v<typename P::mapped_type::used_entity_type>
+> {};
+
+template <class P>
+constexpr bool never_changes_in_game = is_never_changing_entity_pool<P>::value;
+
+/*
+	Entities of the remaining types can still be skipped individually
+	if their flavour guarantees that their solvable state is irrelevant to the logic.
+*/
+
+template <class E>
+bool flavour_never_changes_in_game(const entity_flavour<E>& flav) {
+	if constexpr(never_changes_in_game_v<E>) {
+		return true;
+	}
+	else if constexpr(std::is_same_v<E, plain_sprited_body>) {
+		return 
+			flav.template get<invariants::rigid_body>().body_type == rigid_body_type::ALWAYS_STATIC
+			&& !flav.template get<invariants::animation>().id.is_set() /* Otherwise need to properly serialize animation state */
+		;
+	}
+	else if constexpr(std::is_same_v<E, dynamic_decoration>) {
+		return flav.template get<invariants::animation>().is_irrelevant_to_logic;
+	}
+	else {
+		(void)flav;
+		return false;
+	}
+}
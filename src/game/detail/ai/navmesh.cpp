@@ -0,0 +1,790 @@
+#include <algorithm>
+#include <cmath>
+#include "game/detail/ai/navmesh.h"
+
+namespace {
+	constexpr uint32_t straight_cost_v = 10;
+	constexpr uint32_t diagonal_cost_v = 14;
+
+	/* Longer walkable stretches of a cluster border get a portal at each end instead of a single one in the middle. */
+	constexpr int max_single_portal_entrance_v = 6;
+
+	/* How far to look for a walkable cell if a query starts or ends inside an obstacle. */
+	constexpr int max_snap_distance_v = 4;
+
+	uint32_t octile_distance(const vec2i a, const vec2i b) {
+		const auto dx = static_cast<uint32_t>(std::abs(a.x - b.x));
+		const auto dy = static_cast<uint32_t>(std::abs(a.y - b.y));
+
+		return straight_cost_v * (dx + dy) - (2 * straight_cost_v - diagonal_cost_v) * std::min(dx, dy);
+	}
+
+	struct open_entry {
+		uint32_t f = 0;
+		uint32_t g = 0;
+		uint32_t node = 0;
+
+		bool operator<(const open_entry& b) const {
+			/* Reversed for a min-heap. Ties are broken by the node index so that the order never varies. */
+
+			if (f != b.f) {
+				return f > b.f;
+			}
+
+			return node > b.node;
+		}
+	};
+
+	/*
+		Reused between queries.
+		Stamps tell which nodes were touched by the current search,
+		so that nothing has to be cleared between queries.
+	*/
+
+	struct search_scratch {
+		std::vector<uint32_t> g;
+		std::vector<uint32_t> parent;
+		std::vector<uint32_t> via;
+		std::vector<uint32_t> stamps;
+		std::vector<open_entry> open;
+		uint32_t stamp = 0;
+
+		void prepare(const std::size_t n) {
+			if (stamps.size() < n) {
+				g.resize(n);
+				parent.resize(n);
+				via.resize(n);
+				stamps.resize(n, 0);
+			}
+
+			open.clear();
+
+			if (++stamp == 0) {
+				std::fill(stamps.begin(), stamps.end(), 0);
+				stamp = 1;
+			}
+		}
+
+		void relax(
+			const uint32_t node,
+			const uint32_t new_g,
+			const uint32_t from,
+			const uint32_t from_via,
+			const uint32_t h
+		) {
+			if (stamps[node] != stamp || new_g < g[node]) {
+				stamps[node] = stamp;
+				g[node] = new_g;
+				parent[node] = from;
+				via[node] = from_via;
+
+				open.push_back({ new_g + h, new_g, node });
+				std::push_heap(open.begin(), open.end());
+			}
+		}
+
+		bool pop(open_entry& out) {
+			while (!open.empty()) {
+				std::pop_heap(open.begin(), open.end());
+				out = open.back();
+				open.pop_back();
+
+				/* Skip entries superseded by a cheaper path found later. */
+
+				if (out.g == g[out.node]) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	search_scratch& get_cell_scratch() {
+		thread_local search_scratch scratch;
+		return scratch;
+	}
+
+	search_scratch& get_portal_scratch() {
+		thread_local search_scratch scratch;
+		return scratch;
+	}
+}
+
+void navmesh::reset(const ltrb bounds, const float new_cell_size, const int new_cluster_cells) {
+	origin = bounds.left_top();
+	cell_size = std::max(new_cell_size, 1.f);
+	cluster_cells = std::max(new_cluster_cells, 2);
+
+	size.x = std::max(1, static_cast<int>(std::ceil(bounds.w() / cell_size)));
+	size.y = std::max(1, static_cast<int>(std::ceil(bounds.h() / cell_size)));
+
+	clusters_size.x = (size.x + cluster_cells - 1) / cluster_cells;
+	clusters_size.y = (size.y + cluster_cells - 1) / cluster_cells;
+
+	blocked.assign(static_cast<std::size_t>(size.x) * size.y, 0);
+
+	portals.clear();
+	cluster_first_portal.clear();
+	edges.clear();
+	cached_cells.clear();
+}
+
+bool navmesh::is_set() const {
+	return !blocked.empty();
+}
+
+vec2i navmesh::get_size() const {
+	return size;
+}
+
+float navmesh::get_cell_size() const {
+	return cell_size;
+}
+
+std::size_t navmesh::get_num_portals() const {
+	return portals.size();
+}
+
+navmesh::cell_index navmesh::get_cell_index(const vec2i cell) const {
+	return static_cast<cell_index>(cell.y * size.x + cell.x);
+}
+
+vec2i navmesh::get_cell_pos(const cell_index i) const {
+	return { static_cast<int>(i) % size.x, static_cast<int>(i) / size.x };
+}
+
+vec2i navmesh::get_cell_at(const vec2 world) const {
+	const auto local = (world - origin) / cell_size;
+
+	return {
+		std::clamp(static_cast<int>(std::floor(local.x)), 0, size.x - 1),
+		std::clamp(static_cast<int>(std::floor(local.y)), 0, size.y - 1)
+	};
+}
+
+vec2 navmesh::get_cell_center(const vec2i cell) const {
+	return origin + (vec2(cell) + vec2(0.5f, 0.5f)) * cell_size;
+}
+
+uint32_t navmesh::get_cluster_of(const vec2i cell) const {
+	return static_cast<uint32_t>((cell.y / cluster_cells) * clusters_size.x + cell.x / cluster_cells);
+}
+
+navmesh::cell_range navmesh::get_cluster_range(const uint32_t cluster) const {
+	const auto cx = static_cast<int>(cluster) % clusters_size.x;
+	const auto cy = static_cast<int>(cluster) / clusters_size.x;
+
+	cell_range out;
+	out.lt = { cx * cluster_cells, cy * cluster_cells };
+	out.rb = { std::min(out.lt.x + cluster_cells, size.x), std::min(out.lt.y + cluster_cells, size.y) };
+
+	return out;
+}
+
+navmesh::portal_index navmesh::find_portal(const cell_index cell) const {
+	const auto cluster = get_cluster_of(get_cell_pos(cell));
+
+	const auto first = portals.begin() + cluster_first_portal[cluster];
+	const auto last = portals.begin() + cluster_first_portal[cluster + 1];
+
+	const auto it = std::lower_bound(first, last, cell, [](const portal& p, const cell_index c) { return p.cell < c; });
+	return static_cast<portal_index>(it - portals.begin());
+}
+
+void navmesh::mark_blocked(const vec2i cell) {
+	if (cell.x >= 0 && cell.y >= 0 && cell.x < size.x && cell.y < size.y) {
+		blocked[get_cell_index(cell)] = 1;
+	}
+}
+
+bool navmesh::is_walkable(const vec2i cell) const {
+	if (cell.x < 0 || cell.y < 0 || cell.x >= size.x || cell.y >= size.y) {
+		return false;
+	}
+
+	return blocked[get_cell_index(cell)] == 0;
+}
+
+bool navmesh::is_walkable_at(const vec2 world) const {
+	return !is_set() || is_walkable(get_cell_at(world));
+}
+
+bool navmesh::is_segment_walkable(const vec2 from, const vec2 to) const {
+	return !is_set() || is_line_walkable(get_cell_at(from), get_cell_at(to));
+}
+
+bool navmesh::is_line_walkable(const vec2i from, const vec2i to) const {
+	/*
+		Visits every cell the segment between the two cell centers passes through.
+		Exactly crossing a corner requires both cells adjacent to it to be walkable.
+	*/
+
+	auto x = from.x;
+	auto y = from.y;
+
+	const auto dx = std::abs(to.x - from.x);
+	const auto dy = std::abs(to.y - from.y);
+	const auto sx = to.x > from.x ? 1 : -1;
+	const auto sy = to.y > from.y ? 1 : -1;
+
+	auto error = dx - dy;
+	auto remaining = dx + dy;
+
+	for (;;) {
+		if (!is_walkable({ x, y })) {
+			return false;
+		}
+
+		if (remaining == 0) {
+			return true;
+		}
+
+		if (error > 0) {
+			x += sx;
+			error -= 2 * dy;
+			--remaining;
+		}
+		else if (error < 0) {
+			y += sy;
+			error += 2 * dx;
+			--remaining;
+		}
+		else {
+			if (!is_walkable({ x + sx, y }) || !is_walkable({ x, y + sy })) {
+				return false;
+			}
+
+			x += sx;
+			y += sy;
+			error += 2 * (dx - dy);
+			remaining -= 2;
+		}
+	}
+}
+
+bool navmesh::find_nearest_walkable(const vec2i near, vec2i& out) const {
+	if (is_walkable(near)) {
+		out = near;
+		return true;
+	}
+
+	for (int r = 1; r <= max_snap_distance_v; ++r) {
+		bool found = false;
+		int best_dist_sq = 0;
+
+		for (int y = -r; y <= r; ++y) {
+			for (int x = -r; x <= r; ++x) {
+				if (std::max(std::abs(x), std::abs(y)) != r) {
+					continue;
+				}
+
+				const auto candidate = near + vec2i(x, y);
+				const auto dist_sq = x * x + y * y;
+
+				if (is_walkable(candidate) && (!found || dist_sq < best_dist_sq)) {
+					found = true;
+					best_dist_sq = dist_sq;
+					out = candidate;
+				}
+			}
+		}
+
+		if (found) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool navmesh::find_cell_path(
+	const cell_index from,
+	const cell_index to,
+	const cell_range within,
+	std::vector<cell_index>& out_cells,
+	uint32_t& out_cost
+) const {
+	static const vec2i directions[8] = {
+		{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+		{ 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+	};
+
+	auto& scratch = get_cell_scratch();
+	scratch.prepare(blocked.size());
+
+	const auto goal = get_cell_pos(to);
+
+	scratch.relax(from, 0, from, 0, octile_distance(get_cell_pos(from), goal));
+
+	open_entry current;
+
+	while (scratch.pop(current)) {
+		if (current.node == to) {
+			out_cells.clear();
+
+			for (auto n = to; n != from; n = scratch.parent[n]) {
+				out_cells.push_back(n);
+			}
+
+			out_cells.push_back(from);
+			std::reverse(out_cells.begin(), out_cells.end());
+
+			out_cost = current.g;
+			return true;
+		}
+
+		const auto p = get_cell_pos(current.node);
+
+		for (const auto d : directions) {
+			const auto n = p + d;
+
+			if (!within.contains(n) || !is_walkable(n)) {
+				continue;
+			}
+
+			const bool diagonal = d.x != 0 && d.y != 0;
+
+			if (diagonal) {
+				/* Never cut corners. */
+
+				if (!is_walkable({ p.x + d.x, p.y }) || !is_walkable({ p.x, p.y + d.y })) {
+					continue;
+				}
+			}
+
+			scratch.relax(
+				get_cell_index(n),
+				current.g + (diagonal ? diagonal_cost_v : straight_cost_v),
+				current.node,
+				0,
+				octile_distance(n, goal)
+			);
+		}
+	}
+
+	return false;
+}
+
+void navmesh::add_entrances(std::vector<std::pair<cell_index, cell_index>>& out, const bool vertical_border) const {
+	const auto cell_at = [vertical_border](const int across, const int along) {
+		return vertical_border ? vec2i(across, along) : vec2i(along, across);
+	};
+
+	const auto num_borders = vertical_border ? clusters_size.x : clusters_size.y;
+	const auto length = vertical_border ? size.y : size.x;
+
+	const auto add_pair = [&](const int across, const int along) {
+		out.emplace_back(get_cell_index(cell_at(across, along)), get_cell_index(cell_at(across + 1, along)));
+	};
+
+	for (int border = 1; border < num_borders; ++border) {
+		const auto across = border * cluster_cells - 1;
+
+		for (int segment_start = 0; segment_start < length; segment_start += cluster_cells) {
+			const auto segment_end = std::min(segment_start + cluster_cells, length);
+
+			int run_start = -1;
+
+			for (int along = segment_start; along <= segment_end; ++along) {
+				const bool open =
+					along < segment_end
+					&& is_walkable(cell_at(across, along))
+					&& is_walkable(cell_at(across + 1, along))
+				;
+
+				if (open) {
+					if (run_start == -1) {
+						run_start = along;
+					}
+
+					continue;
+				}
+
+				if (run_start != -1) {
+					const auto run_end = along - 1;
+					const auto run_length = run_end - run_start + 1;
+
+					if (run_length <= max_single_portal_entrance_v) {
+						add_pair(across, run_start + run_length / 2);
+					}
+					else {
+						add_pair(across, run_start);
+						add_pair(across, run_end);
+					}
+
+					run_start = -1;
+				}
+			}
+		}
+	}
+}
+
+void navmesh::build_portals() {
+	std::vector<std::pair<cell_index, cell_index>> entrances;
+
+	add_entrances(entrances, true);
+	add_entrances(entrances, false);
+
+	const auto num_clusters = static_cast<std::size_t>(clusters_size.x) * clusters_size.y;
+
+	{
+		std::vector<std::vector<cell_index>> portal_cells_of_cluster(num_clusters);
+
+		for (const auto& e : entrances) {
+			portal_cells_of_cluster[get_cluster_of(get_cell_pos(e.first))].push_back(e.first);
+			portal_cells_of_cluster[get_cluster_of(get_cell_pos(e.second))].push_back(e.second);
+		}
+
+		portals.clear();
+		cluster_first_portal.assign(num_clusters + 1, 0);
+
+		for (std::size_t c = 0; c < num_clusters; ++c) {
+			auto& cells = portal_cells_of_cluster[c];
+
+			std::sort(cells.begin(), cells.end());
+			cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+			cluster_first_portal[c] = static_cast<uint32_t>(portals.size());
+
+			for (const auto cell : cells) {
+				portal p;
+				p.cell = cell;
+				portals.push_back(p);
+			}
+		}
+
+		cluster_first_portal[num_clusters] = static_cast<uint32_t>(portals.size());
+	}
+
+	std::vector<std::vector<portal_edge>> edges_of_portal(portals.size());
+	cached_cells.clear();
+
+	const auto add_edge = [&](const portal_index from, const portal_index to, const uint32_t cost, const uint32_t first_cell) {
+		portal_edge e;
+		e.to = to;
+		e.cost = cost;
+		e.first_cell = first_cell;
+		e.num_cells = static_cast<uint32_t>(cached_cells.size()) - first_cell;
+
+		edges_of_portal[from].push_back(e);
+	};
+
+	for (const auto& e : entrances) {
+		const auto a = find_portal(e.first);
+		const auto b = find_portal(e.second);
+
+		{
+			const auto first_cell = static_cast<uint32_t>(cached_cells.size());
+			cached_cells.push_back(e.second);
+			add_edge(a, b, straight_cost_v, first_cell);
+		}
+
+		{
+			const auto first_cell = static_cast<uint32_t>(cached_cells.size());
+			cached_cells.push_back(e.first);
+			add_edge(b, a, straight_cost_v, first_cell);
+		}
+	}
+
+	std::vector<cell_index> path;
+
+	for (std::size_t c = 0; c < num_clusters; ++c) {
+		const auto range = get_cluster_range(static_cast<uint32_t>(c));
+		const auto first = cluster_first_portal[c];
+		const auto last = cluster_first_portal[c + 1];
+
+		for (auto i = first; i < last; ++i) {
+			for (auto j = i + 1; j < last; ++j) {
+				uint32_t cost = 0;
+
+				if (!find_cell_path(portals[i].cell, portals[j].cell, range, path, cost)) {
+					continue;
+				}
+
+				{
+					const auto first_cell = static_cast<uint32_t>(cached_cells.size());
+					cached_cells.insert(cached_cells.end(), path.begin() + 1, path.end());
+					add_edge(i, j, cost, first_cell);
+				}
+
+				{
+					const auto first_cell = static_cast<uint32_t>(cached_cells.size());
+					cached_cells.insert(cached_cells.end(), path.rbegin() + 1, path.rend());
+					add_edge(j, i, cost, first_cell);
+				}
+			}
+		}
+	}
+
+	edges.clear();
+
+	for (std::size_t p = 0; p < portals.size(); ++p) {
+		portals[p].first_edge = static_cast<uint32_t>(edges.size());
+		portals[p].num_edges = static_cast<uint32_t>(edges_of_portal[p].size());
+
+		edges.insert(edges.end(), edges_of_portal[p].begin(), edges_of_portal[p].end());
+	}
+}
+
+bool navmesh::find_abstract_path(const cell_index from, const cell_index to, std::vector<cell_index>& out_cells) const {
+	struct connection {
+		portal_index portal = 0;
+		uint32_t cost = 0;
+		uint32_t first_cell = 0;
+		uint32_t num_cells = 0;
+	};
+
+	thread_local std::vector<connection> start_connections;
+	thread_local std::vector<connection> goal_connections;
+	thread_local std::vector<cell_index> connection_cells;
+	thread_local std::vector<cell_index> path;
+	thread_local std::vector<uint32_t> goal_connection_of_portal;
+
+	start_connections.clear();
+	goal_connections.clear();
+	connection_cells.clear();
+
+	const auto start_pos = get_cell_pos(from);
+	const auto goal_pos = get_cell_pos(to);
+
+	const auto start_cluster = get_cluster_of(start_pos);
+	const auto goal_cluster = get_cluster_of(goal_pos);
+
+	const auto connect = [&](const uint32_t cluster, const bool towards_portals, std::vector<connection>& out) {
+		const auto range = get_cluster_range(cluster);
+
+		for (auto p = cluster_first_portal[cluster]; p < cluster_first_portal[cluster + 1]; ++p) {
+			uint32_t cost = 0;
+
+			const bool found =
+				towards_portals
+				? find_cell_path(from, portals[p].cell, range, path, cost)
+				: find_cell_path(portals[p].cell, to, range, path, cost)
+			;
+
+			if (found) {
+				connection c;
+				c.portal = p;
+				c.cost = cost;
+				c.first_cell = static_cast<uint32_t>(connection_cells.size());
+				c.num_cells = static_cast<uint32_t>(path.size() - 1);
+
+				connection_cells.insert(connection_cells.end(), path.begin() + 1, path.end());
+				out.push_back(c);
+			}
+		}
+	};
+
+	connect(start_cluster, true, start_connections);
+	connect(goal_cluster, false, goal_connections);
+
+	if (start_connections.empty() || goal_connections.empty()) {
+		return false;
+	}
+
+	const auto first_goal_portal = cluster_first_portal[goal_cluster];
+	const auto no_connection = static_cast<uint32_t>(-1);
+
+	goal_connection_of_portal.assign(cluster_first_portal[goal_cluster + 1] - first_goal_portal, no_connection);
+
+	for (std::size_t i = 0; i < goal_connections.size(); ++i) {
+		goal_connection_of_portal[goal_connections[i].portal - first_goal_portal] = static_cast<uint32_t>(i);
+	}
+
+	const auto start_node = static_cast<uint32_t>(portals.size());
+	const auto goal_node = start_node + 1;
+
+	const auto heuristic = [&](const portal_index p) {
+		return octile_distance(get_cell_pos(portals[p].cell), goal_pos);
+	};
+
+	auto& scratch = get_portal_scratch();
+	scratch.prepare(portals.size() + 2);
+
+	scratch.relax(start_node, 0, start_node, 0, octile_distance(start_pos, goal_pos));
+
+	open_entry current;
+
+	while (scratch.pop(current)) {
+		const auto node = current.node;
+
+		if (node == goal_node) {
+			thread_local std::vector<uint32_t> hops;
+			hops.clear();
+
+			for (auto n = goal_node; n != start_node; n = scratch.parent[n]) {
+				hops.push_back(n);
+			}
+
+			std::reverse(hops.begin(), hops.end());
+
+			out_cells.clear();
+			out_cells.push_back(from);
+
+			auto previous = start_node;
+
+			for (const auto n : hops) {
+				const auto via = scratch.via[n];
+
+				const auto append_connection = [&](const connection& c) {
+					const auto first = connection_cells.begin() + c.first_cell;
+					out_cells.insert(out_cells.end(), first, first + c.num_cells);
+				};
+
+				if (previous == start_node) {
+					append_connection(start_connections[via]);
+				}
+				else if (n == goal_node) {
+					append_connection(goal_connections[via]);
+				}
+				else {
+					const auto& e = edges[via];
+					const auto first = cached_cells.begin() + e.first_cell;
+					out_cells.insert(out_cells.end(), first, first + e.num_cells);
+				}
+
+				previous = n;
+			}
+
+			return true;
+		}
+
+		if (node == start_node) {
+			for (std::size_t i = 0; i < start_connections.size(); ++i) {
+				const auto& c = start_connections[i];
+				scratch.relax(c.portal, c.cost, start_node, static_cast<uint32_t>(i), heuristic(c.portal));
+			}
+
+			continue;
+		}
+
+		const auto& p = portals[node];
+
+		for (auto e = p.first_edge; e < p.first_edge + p.num_edges; ++e) {
+			const auto& edge = edges[e];
+			scratch.relax(edge.to, current.g + edge.cost, node, e, heuristic(edge.to));
+		}
+
+		if (node >= first_goal_portal && node - first_goal_portal < goal_connection_of_portal.size()) {
+			const auto c = goal_connection_of_portal[node - first_goal_portal];
+
+			if (c != no_connection) {
+				scratch.relax(goal_node, current.g + goal_connections[c].cost, node, c, 0);
+			}
+		}
+	}
+
+	return false;
+}
+
+bool navmesh::find_path(const vec2 from, const vec2 to, std::vector<vec2>& waypoints) const {
+	waypoints.clear();
+
+	if (!is_set()) {
+		waypoints.push_back(to);
+		return true;
+	}
+
+	const auto target_cell = get_cell_at(to);
+
+	vec2i start;
+	vec2i goal;
+
+	if (!find_nearest_walkable(get_cell_at(from), start) || !find_nearest_walkable(target_cell, goal)) {
+		return false;
+	}
+
+	/* If the target itself lies in an obstacle, stop at the closest walkable cell instead. */
+	const auto final_point = goal == target_cell ? to : get_cell_center(goal);
+
+	const auto start_index = get_cell_index(start);
+	const auto goal_index = get_cell_index(goal);
+
+	if (start_index == goal_index) {
+		waypoints.push_back(final_point);
+		return true;
+	}
+
+	thread_local std::vector<cell_index> cells;
+
+	uint32_t cost = 0;
+
+	const auto start_cluster = get_cluster_of(start);
+
+	const bool found_within_cluster =
+		start_cluster == get_cluster_of(goal)
+		&& find_cell_path(start_index, goal_index, get_cluster_range(start_cluster), cells, cost)
+	;
+
+	if (!found_within_cluster && !find_abstract_path(start_index, goal_index, cells)) {
+		return false;
+	}
+
+	/* Pull the string: skip every cell that can be reached in a straight line. */
+
+	std::size_t i = 0;
+
+	while (i + 1 < cells.size()) {
+		auto j = i + 1;
+
+		while (j + 1 < cells.size() && is_line_walkable(get_cell_pos(cells[i]), get_cell_pos(cells[j + 1]))) {
+			++j;
+		}
+
+		waypoints.push_back(get_cell_center(get_cell_pos(cells[j])));
+		i = j;
+	}
+
+	waypoints.back() = final_point;
+	return true;
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("Navmesh FindsPathAroundWall") {
+	navmesh mesh;
+	mesh.reset(ltrb(0.f, 0.f, 640.f, 640.f), 10.f, 8);
+
+	/* A wall across the whole width but for a gap at the very right. */
+
+	for (int x = 0; x < 60; ++x) {
+		mesh.mark_blocked({ x, 32 });
+	}
+
+	mesh.build_portals();
+
+	REQUIRE(mesh.get_num_portals() > 0);
+
+	std::vector<vec2> waypoints;
+
+	REQUIRE(mesh.find_path(vec2(15.f, 15.f), vec2(15.f, 625.f), waypoints));
+	REQUIRE(!waypoints.empty());
+	REQUIRE(waypoints.back() == vec2(15.f, 625.f));
+
+	auto previous = vec2(15.f, 15.f);
+	bool went_through_gap = false;
+
+	for (const auto& w : waypoints) {
+		REQUIRE(mesh.is_segment_walkable(previous, w));
+
+		if (w.x >= 600.f) {
+			went_through_gap = true;
+		}
+
+		previous = w;
+	}
+
+	REQUIRE(went_through_gap);
+
+	for (int x = 60; x < 64; ++x) {
+		mesh.mark_blocked({ x, 32 });
+	}
+
+	mesh.build_portals();
+
+	REQUIRE(!mesh.find_path(vec2(15.f, 15.f), vec2(15.f, 625.f), waypoints));
+	REQUIRE(mesh.find_path(vec2(15.f, 15.f), vec2(625.f, 15.f), waypoints));
+}
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "augs/math/vec2.h"
+#include "augs/math/rects.h"
+
+/*
+	Walkability grid of an arena together with an abstract graph for hierarchical A*.
+
+	The grid is divided into square clusters.
+	Wherever two neighboring clusters share a walkable stretch of their border,
+	a pair of portals connects them.
+	Paths between every two portals of a single cluster are precomputed once,
+	so a long query only searches the small graph of portals
+	and then splices the cached paths together.
+
+	All path costs are integers so that the results never depend on the floating point environment.
+*/
+
+class navmesh {
+public:
+	using cell_index = uint32_t;
+	using portal_index = uint32_t;
+
+private:
+	struct portal {
+		cell_index cell = 0;
+		uint32_t first_edge = 0;
+		uint32_t num_edges = 0;
+	};
+
+	struct portal_edge {
+		portal_index to = 0;
+		uint32_t cost = 0;
+
+		/* Range in cached_cells. Leads from the portal to the other one, excluding the first cell. */
+		uint32_t first_cell = 0;
+		uint32_t num_cells = 0;
+	};
+
+	struct cell_range {
+		vec2i lt;
+		vec2i rb;
+
+		bool contains(const vec2i c) const {
+			return c.x >= lt.x && c.y >= lt.y && c.x < rb.x && c.y < rb.y;
+		}
+	};
+
+	vec2 origin;
+	float cell_size = 0.f;
+	vec2i size;
+
+	int cluster_cells = 0;
+	vec2i clusters_size;
+
+	std::vector<uint8_t> blocked;
+
+	std::vector<portal> portals;
+	std::vector<uint32_t> cluster_first_portal;
+	std::vector<portal_edge> edges;
+	std::vector<cell_index> cached_cells;
+
+	vec2i get_cell_pos(cell_index) const;
+	uint32_t get_cluster_of(vec2i) const;
+	cell_range get_cluster_range(uint32_t) const;
+	portal_index find_portal(cell_index) const;
+
+	bool is_walkable(vec2i) const;
+	bool is_line_walkable(vec2i from, vec2i to) const;
+
+	bool find_nearest_walkable(vec2i near, vec2i& out) const;
+
+	bool find_cell_path(
+		cell_index from,
+		cell_index to,
+		cell_range within,
+		std::vector<cell_index>& out_cells,
+		uint32_t& out_cost
+	) const;
+
+	bool find_abstract_path(cell_index from, cell_index to, std::vector<cell_index>& out_cells) const;
+
+	void add_entrances(std::vector<std::pair<cell_index, cell_index>>& out, bool vertical_border) const;
+
+public:
+	void reset(ltrb bounds, float cell_size, int cluster_cells);
+
+	void mark_blocked(vec2i cell);
+	void build_portals();
+
+	bool is_set() const;
+
+	vec2i get_size() const;
+	float get_cell_size() const;
+	std::size_t get_num_portals() const;
+
+	vec2i get_cell_at(vec2 world) const;
+	vec2 get_cell_center(vec2i cell) const;
+	cell_index get_cell_index(vec2i cell) const;
+
+	bool is_walkable_at(vec2 world) const;
+	bool is_segment_walkable(vec2 from, vec2 to) const;
+
+	/*
+		Fills waypoints leading from "from" to "to", excluding the starting position.
+		Returns false if there is no way.
+	*/
+
+	bool find_path(vec2 from, vec2 to, std::vector<vec2>& waypoints) const;
+};
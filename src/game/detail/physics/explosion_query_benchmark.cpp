@@ -0,0 +1,127 @@
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "augs/misc/timing/timer.h"
+#include "augs/misc/randomization.h"
+#include "augs/string/typesafe_sprintf.h"
+
+#include "game/detail/physics/physics_queries.h"
+#include "game/detail/physics/explosion_query_benchmark.h"
+
+std::string benchmark_explosion_queries() {
+	b2World world(b2Vec2(0.f, 0.f));
+	const auto si = si_scaling();
+
+	auto rng = randomization(1337);
+
+	/* Roughly the density of crates, items and characters on a busy map. */
+
+	const auto num_bodies = 20000;
+	const auto world_half_meters = 150.f;
+
+	for (int i = 0; i < num_bodies; ++i) {
+		b2BodyDef def;
+		def.transform.SetIdentity();
+		def.transform.p.Set(rng.randval(-world_half_meters, world_half_meters), rng.randval(-world_half_meters, world_half_meters));
+
+		b2PolygonShape shape;
+		shape.SetAsBox(0.5f, 0.5f);
+
+		b2FixtureDef fixture_def;
+		fixture_def.shape = &shape;
+
+		world.CreateBody(&def)->CreateFixture(&fixture_def);
+	}
+
+	/* An explosion fan of a typical grenade: about 60 visibility triangles of 500 px. */
+
+	const auto num_explosions = 2000;
+	const auto triangles_per_explosion = 64;
+	const auto explosion_radius = 500.f;
+
+	std::vector<std::array<vec2, 3>> triangles;
+	triangles.reserve(num_explosions * triangles_per_explosion);
+
+	const auto world_half_pixels = si.get_pixels(world_half_meters);
+
+	for (int e = 0; e < num_explosions; ++e) {
+		const auto center = vec2(rng.randval(-world_half_pixels, world_half_pixels), rng.randval(-world_half_pixels, world_half_pixels));
+
+		for (int i = 0; i < triangles_per_explosion; ++i) {
+			const auto a = vec2::from_degrees(i * 360.f / triangles_per_explosion);
+			const auto b = vec2::from_degrees((i + 1) * 360.f / triangles_per_explosion);
+
+			triangles.push_back({ center, center + a * explosion_radius, center + b * explosion_radius });
+		}
+	}
+
+	using hit = std::pair<const b2Fixture*, std::size_t>;
+
+	std::vector<hit> single_hits;
+	std::vector<hit> batched_hits;
+
+	single_hits.reserve(1 << 20);
+	batched_hits.reserve(1 << 20);
+
+	const auto filter = b2Filter();
+
+	auto run_single = [&]() {
+		single_hits.clear();
+
+		for (int e = 0; e < num_explosions; ++e) {
+			for (int i = 0; i < triangles_per_explosion; ++i) {
+				const auto ti = static_cast<std::size_t>(e * triangles_per_explosion + i);
+
+				for_each_intersection_with_triangle(world, si, triangles[ti], filter, [&](const b2Fixture& f, vec2, vec2) {
+					single_hits.emplace_back(std::addressof(f), ti);
+					return callback_result::CONTINUE;
+				});
+			}
+		}
+	};
+
+	auto run_batched = [&]() {
+		batched_hits.clear();
+
+		for (int e = 0; e < num_explosions; ++e) {
+			const auto first = static_cast<std::size_t>(e * triangles_per_explosion);
+
+			for_each_intersection_with_triangles(world, si, triangles.data() + first, triangles_per_explosion, filter, [&](const b2Fixture& f, vec2, vec2, const std::size_t i) {
+				batched_hits.emplace_back(std::addressof(f), first + i);
+				return callback_result::CONTINUE;
+			});
+		}
+	};
+
+	/* Warm up, so that neither variant pays for first touching the memory. */
+
+	run_single();
+	run_batched();
+
+	double single_ms = 0.0;
+	double batched_ms = 0.0;
+
+	{
+		augs::timer t;
+		run_single();
+		single_ms = t.get<std::chrono::milliseconds>();
+	}
+
+	{
+		augs::timer t;
+		run_batched();
+		batched_ms = t.get<std::chrono::milliseconds>();
+	}
+
+	std::string report;
+
+	report += typesafe_sprintf("Explosion queries: %x bodies, %x explosions of %x triangles\n", num_bodies, num_explosions, triangles_per_explosion);
+	report += typesafe_sprintf("Hits: %x\n", single_hits.size());
+	report += typesafe_sprintf("One query per triangle: %f2 ms\n", single_ms);
+	report += typesafe_sprintf("One query per explosion: %f2 ms\n", batched_ms);
+	report += typesafe_sprintf("Speedup: %f2x\n", single_ms / std::max(batched_ms, 1e-9));
+	report += typesafe_sprintf("Same hits: %x\n", single_hits == batched_hits ? "yes" : "no");
+
+	return report;
+}
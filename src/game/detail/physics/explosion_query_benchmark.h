@@ -0,0 +1,13 @@
+#pragma once
+#include <string>
+
+/*
+	Builds a crowded Box2D world with no content needed
+	and resolves the same explosion fans twice:
+	once with one broadphase query per triangle
+	and once with for_each_intersection_with_triangles.
+
+	Reports the time spent in each along with whether both reported the same hits.
+*/
+
+std::string benchmark_explosion_queries();
@@ -1,5 +1,8 @@
 #pragma once
 #include <type_traits>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 #include <Box2D/Common/b2Math.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
@@ -50,6 +53,46 @@ void for_each_in_aabb_meters(
 	b2world.QueryAABB(&in, aabb);
 }
 
+/*
+	Queries many AABBs with a single traversal of the broadphase tree.
+	The callback receives the fixture and the index of the AABB it was found in.
+	Hits of different queries come interleaved,
+	but the hits of every single query come in the same order as with for_each_in_aabb_meters.
+	Returning ABORT stops only the query with that index.
+*/
+
+template <class F>
+void for_each_in_aabbs_meters(
+	const b2World& b2world,
+	const b2AABB* const aabbs,
+	const std::size_t count,
+	const b2Filter filter,
+	F callback
+) {
+	const auto& broad_phase = b2world.GetContactManager().m_broadPhase;
+
+	struct query_aabbs_input {
+		const b2BroadPhase& broad_phase;
+		b2Filter filter;
+		F& call;
+
+		bool QueryCallback(const int32 proxy_id, const int32 query_index) {
+			const auto proxy = static_cast<b2FixtureProxy*>(broad_phase.GetUserData(proxy_id));
+			auto& fixture = *proxy->fixture;
+
+			if (b2ContactFilter::ShouldCollide(&filter, &fixture.GetFilterData())) {
+				return call(fixture, static_cast<std::size_t>(query_index)) == callback_result::CONTINUE;
+			}
+
+			return true;
+		}
+	};
+
+	auto in = query_aabbs_input { broad_phase, filter, callback };
+
+	broad_phase.QueryBatch(&in, aabbs, static_cast<int32>(count));
+}
+
 template <class S, class F>
 void for_each_intersection_with_shape_meters(
 	const b2World& b2world,
@@ -190,6 +233,114 @@ void for_each_intersection_with_triangle(
 	);
 }
 
+/*
+	Same as calling for_each_intersection_with_triangle for every triangle in turn,
+	and the callback is invoked in exactly that order (with the index of the triangle),
+	but the broadphase is traversed only once for all of them.
+*/
+
+template <class F>
+void for_each_intersection_with_triangles(
+	const b2World& b2world,
+	const si_scaling si,
+	const std::array<vec2, 3>* const triangles,
+	const std::size_t count,
+	const b2Filter filter,
+	F callback
+) {
+	struct triangle_hit {
+		uint32_t triangle_index;
+		const b2Fixture* fixture;
+		b2Vec2 point_a;
+		b2Vec2 point_b;
+	};
+
+	thread_local std::vector<b2PolygonShape> shapes;
+	thread_local std::vector<b2AABB> aabbs;
+	thread_local std::vector<triangle_hit> hits;
+
+	shapes.clear();
+	aabbs.clear();
+	hits.clear();
+
+	b2Transform null_transform;
+	null_transform.SetIdentity();
+
+	for (std::size_t i = 0; i < count; ++i) {
+		shapes.emplace_back(to_polygon_shape(triangles[i], si));
+
+		b2AABB aabb;
+		shapes.back().ComputeAABB(&aabb, null_transform, 0);
+		aabbs.push_back(aabb);
+	}
+
+	for_each_in_aabbs_meters(
+		b2world,
+		aabbs.data(),
+		aabbs.size(),
+		filter,
+		[&](const b2Fixture& fixture, const std::size_t i) {
+			constexpr auto index_a = 0;
+			constexpr auto index_b = 0;
+
+			const auto result = b2TestOverlapInfo(
+				std::addressof(shapes[i]),
+				index_a,
+				fixture.GetShape(),
+				index_b,
+				null_transform,
+				fixture.GetBody()->GetTransform()
+			);
+
+			if (result.overlap) {
+				hits.push_back({ static_cast<uint32_t>(i), std::addressof(fixture), result.pointA, result.pointB });
+			}
+
+			return callback_result::CONTINUE;
+		}
+	);
+
+	/* Stable, so the hits of each triangle stay in the order a separate query would find them. */
+
+	std::stable_sort(
+		hits.begin(),
+		hits.end(),
+		[](const triangle_hit& a, const triangle_hit& b) {
+			return a.triangle_index < b.triangle_index;
+		}
+	);
+
+	/* 
+		The callback might query again, 
+		so the hits are moved out of the thread_local scratch for the time of the calls.
+	*/
+
+	auto found_hits = std::move(hits);
+	hits = {};
+
+	std::size_t aborted_triangle = std::numeric_limits<std::size_t>::max();
+
+	for (const auto& h : found_hits) {
+		if (h.triangle_index == aborted_triangle) {
+			continue;
+		}
+
+		const auto result = callback(
+			*h.fixture,
+			si.get_pixels(h.point_a),
+			si.get_pixels(h.point_b),
+			static_cast<std::size_t>(h.triangle_index)
+		);
+
+		if (result == callback_result::ABORT) {
+			aborted_triangle = h.triangle_index;
+		}
+	}
+
+	found_hits.clear();
+	hits = std::move(found_hits);
+}
+
 template <class C, class F>
 void for_each_intersection_with_polygon(
 	const b2World& b2world,
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <cstddef>
 
 #include "augs/math/si_scaling.h"
 #include "augs/math/camera_cone.h"
@@ -18,6 +19,15 @@ void for_each_in_aabb_meters(
 	F callback
 );
 
+template <class F>
+void for_each_in_aabbs_meters(
+	const b2World& b2world,
+	const b2AABB* const aabbs,
+	const std::size_t count,
+	const b2Filter filter,
+	F callback
+);
+
 template <class F>
 void for_each_intersection_with_shape_meters_generic(
 	const b2World& b2world,
@@ -75,6 +85,16 @@ void for_each_intersection_with_triangle(
 	F callback
 );
 
+template <class F>
+void for_each_intersection_with_triangles(
+	const b2World& b2world,
+	const si_scaling si,
+	const std::array<vec2, 3>* const triangles,
+	const std::size_t count,
+	const b2Filter filter,
+	F callback
+);
+
 template <class C, class F>
 void for_each_intersection_with_polygon(
 	const b2World& b2world,
@@ -1,10 +1,21 @@
+#include <array>
+#include <algorithm>
+
 #include "game/inferred_caches/physics_world_cache.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
 
+#include "game/detail/physics/physics_queries.h"
 #include "game/detail/physics/physics_scripts.h"
 #include "game/enums/filters.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAY_CAST_BATCH_SSE2 1
+#include <emmintrin.h>
+#else
+#define RAY_CAST_BATCH_SSE2 0
+#endif
+
 struct raycast_input : public b2RayCastCallback {
 	entity_id subject;
 	b2Filter subject_filter;
@@ -158,4 +169,383 @@ physics_raycast_output physics_world_cache::ray_cast_px(
 	out.intersection = si.get_pixels(out.intersection);
 
 	return out;
-}
\ No newline at end of file
+}
+
+#if RAY_CAST_BATCH_SSE2
+/*
+	Four-lane version of b2PolygonShape::RayCast.
+	Every lane performs exactly the same float operations in the same order as the scalar routine,
+	so the fractions come out bit for bit identical.
+	A lane that misses gets the index of -1.
+*/
+
+static void ray_cast_polygon_x4(
+	const b2PolygonShape& poly,
+	const b2Transform& xf,
+	const b2Vec2 p1_local,
+	const float* const p2x,
+	const float* const p2y,
+	const float* const max_fractions,
+	float* const out_fractions,
+	int* const out_indices
+) {
+	const auto qc = _mm_set1_ps(xf.q.c);
+	const auto qs = _mm_set1_ps(xf.q.s);
+	const auto neg_qs = _mm_set1_ps(-xf.q.s);
+
+	const auto tx = _mm_sub_ps(_mm_loadu_ps(p2x), _mm_set1_ps(xf.p.x));
+	const auto ty = _mm_sub_ps(_mm_loadu_ps(p2y), _mm_set1_ps(xf.p.y));
+
+	/* b2MulT(xf.q, input.p2 - xf.p) */
+	const auto p2lx = _mm_add_ps(_mm_mul_ps(qc, tx), _mm_mul_ps(qs, ty));
+	const auto p2ly = _mm_add_ps(_mm_mul_ps(neg_qs, tx), _mm_mul_ps(qc, ty));
+
+	const auto dx = _mm_sub_ps(p2lx, _mm_set1_ps(p1_local.x));
+	const auto dy = _mm_sub_ps(p2ly, _mm_set1_ps(p1_local.y));
+
+	const auto zero = _mm_setzero_ps();
+
+	auto lower = zero;
+	auto upper = _mm_loadu_ps(max_fractions);
+	auto index = _mm_set1_epi32(-1);
+	auto dead = _mm_setzero_ps();
+
+	for (int32 i = 0; i < poly.m_count; ++i) {
+		const auto& n = poly.m_normals[i];
+		const auto& v = poly.m_vertices[i];
+
+		const auto numerator = _mm_set1_ps(b2Dot(n, v - p1_local));
+		const auto denominator = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(n.x), dx), _mm_mul_ps(_mm_set1_ps(n.y), dy));
+
+		const auto den_zero = _mm_cmpeq_ps(denominator, zero);
+		dead = _mm_or_ps(dead, _mm_and_ps(den_zero, _mm_cmplt_ps(numerator, zero)));
+
+		const auto quotient = _mm_div_ps(numerator, denominator);
+
+		const auto enters = _mm_and_ps(
+			_mm_cmplt_ps(denominator, zero),
+			_mm_cmplt_ps(numerator, _mm_mul_ps(lower, denominator))
+		);
+
+		const auto exits = _mm_andnot_ps(
+			enters,
+			_mm_and_ps(
+				_mm_cmpgt_ps(denominator, zero),
+				_mm_cmplt_ps(numerator, _mm_mul_ps(upper, denominator))
+			)
+		);
+
+		lower = _mm_or_ps(_mm_and_ps(enters, quotient), _mm_andnot_ps(enters, lower));
+		upper = _mm_or_ps(_mm_and_ps(exits, quotient), _mm_andnot_ps(exits, upper));
+
+		const auto enters_i = _mm_castps_si128(enters);
+		index = _mm_or_si128(_mm_and_si128(enters_i, _mm_set1_epi32(i)), _mm_andnot_si128(enters_i, index));
+
+		dead = _mm_or_ps(dead, _mm_cmplt_ps(upper, lower));
+	}
+
+	index = _mm_or_si128(index, _mm_castps_si128(dead));
+
+	_mm_storeu_ps(out_fractions, lower);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out_indices), index);
+}
+#endif
+
+void physics_world_cache::ray_cast_batch(
+	const vec2 origin_meters,
+	const std::vector<vec2>& destinations_meters,
+	const b2Filter filter,
+	const entity_id ignore_entity,
+	std::vector<physics_raycast_output>& outputs
+) const {
+	const auto n = destinations_meters.size();
+
+	outputs.clear();
+	outputs.resize(n);
+
+	if (n == 0) {
+		return;
+	}
+
+	constexpr std::size_t lanes = 4;
+
+	struct group {
+		std::array<float, lanes> p2x;
+		std::array<float, lanes> p2y;
+		std::array<bool, lanes> castable = {};
+	};
+
+	struct candidate {
+		uint32_t group_index;
+		b2Fixture* fixture;
+	};
+
+	thread_local std::vector<float> max_fractions;
+	thread_local std::vector<group> groups;
+	thread_local std::vector<b2AABB> group_aabbs;
+	thread_local std::vector<candidate> candidates;
+
+	max_fractions.assign(n, 1.0f);
+	groups.clear();
+	group_aabbs.clear();
+	candidates.clear();
+
+	const auto p1 = b2Vec2(origin_meters);
+
+	for (std::size_t g = 0; g < n; g += lanes) {
+		const auto count = std::min(lanes, n - g);
+
+		group gr;
+
+		b2AABB group_aabb;
+		group_aabb.lowerBound = p1;
+		group_aabb.upperBound = p1;
+
+		for (std::size_t k = 0; k < lanes; ++k) {
+			gr.p2x[k] = p1.x;
+			gr.p2y[k] = p1.y;
+
+			if (k < count) {
+				const auto d = destinations_meters[g + k];
+
+				/* Same condition as in ray_cast. */
+				if ((origin_meters - d).length_sq() > 0.f) {
+					gr.castable[k] = true;
+
+					gr.p2x[k] = d.x;
+					gr.p2y[k] = d.y;
+
+					group_aabb.lowerBound = b2Min(group_aabb.lowerBound, b2Vec2(d));
+					group_aabb.upperBound = b2Max(group_aabb.upperBound, b2Vec2(d));
+				}
+			}
+		}
+
+		groups.push_back(gr);
+		group_aabbs.push_back(group_aabb);
+	}
+
+	/* 
+		Every fixture that the broadphase could test for a ray has its AABB overlap the bounding box of that ray,
+		so a single traversal with the bounding boxes of all groups finds the candidates of every group.
+	*/
+
+	for_each_in_aabbs_meters(
+		group_aabbs.data(),
+		group_aabbs.size(),
+		filter,
+		[&](const b2Fixture& f, const std::size_t group_index) {
+			const auto fixture_entity = f.GetBody()->GetUserData();
+
+			if (ignore_entity == entity_id() || fixture_entity != FixtureUserdata(ignore_entity)) {
+				candidates.push_back({ static_cast<uint32_t>(group_index), const_cast<b2Fixture*>(std::addressof(f)) });
+			}
+
+			return callback_result::CONTINUE;
+		}
+	);
+
+	/* Hits of a single query keep the broadphase order, as with ray_cast. */
+
+	std::stable_sort(
+		candidates.begin(),
+		candidates.end(),
+		[](const candidate& a, const candidate& b) {
+			return a.group_index < b.group_index;
+		}
+	);
+
+	auto report = [&](const std::size_t i, b2Fixture* const fixture, const float32 fraction, const b2Vec2 normal) {
+		max_fractions[i] = fraction;
+
+		auto& out = outputs[i];
+		out.hit = true;
+		out.what_entity = fixture->GetBody()->GetUserData();
+		out.what_fixture = fixture;
+		out.normal = normal;
+	};
+
+	for (const auto& c : candidates) {
+		const auto& gr = groups[c.group_index];
+		const auto g = std::size_t(c.group_index) * lanes;
+		const auto count = std::min(lanes, n - g);
+
+		auto& fixture = *c.fixture;
+		const auto& shape = *fixture.GetShape();
+
+#if RAY_CAST_BATCH_SSE2
+		if (shape.GetType() == b2Shape::e_polygon) {
+			const auto& poly = static_cast<const b2PolygonShape&>(shape);
+			const auto& xf = fixture.GetBody()->GetTransform();
+
+			std::array<float, lanes> current_max;
+			std::array<float, lanes> fractions;
+			std::array<int, lanes> indices;
+
+			for (std::size_t k = 0; k < lanes; ++k) {
+				current_max[k] = k < count ? max_fractions[g + k] : 1.0f;
+			}
+
+			ray_cast_polygon_x4(
+				poly,
+				xf,
+				b2MulT(xf.q, p1 - xf.p),
+				gr.p2x.data(),
+				gr.p2y.data(),
+				current_max.data(),
+				fractions.data(),
+				indices.data()
+			);
+
+			for (std::size_t k = 0; k < count; ++k) {
+				if (gr.castable[k] && indices[k] >= 0) {
+					report(g + k, c.fixture, fractions[k], b2Mul(xf.q, poly.m_normals[indices[k]]));
+				}
+			}
+
+			continue;
+		}
+#endif
+
+		for (std::size_t k = 0; k < count; ++k) {
+			if (!gr.castable[k]) {
+				continue;
+			}
+
+			for (int32 child = 0; child < shape.GetChildCount(); ++child) {
+				b2RayCastInput input;
+				input.p1 = p1;
+				input.p2 = b2Vec2(gr.p2x[k], gr.p2y[k]);
+				input.maxFraction = max_fractions[g + k];
+
+				b2RayCastOutput output;
+
+				if (fixture.RayCast(&output, input, child)) {
+					report(g + k, c.fixture, output.fraction, output.normal);
+				}
+			}
+		}
+	}
+
+	for (std::size_t i = 0; i < n; ++i) {
+		auto& out = outputs[i];
+
+		if (out.hit) {
+			/* Same as in b2WorldRayCastWrapper. */
+			const float32 fraction = max_fractions[i];
+			const b2Vec2 point = (1.0f - fraction) * p1 + fraction * b2Vec2(destinations_meters[i]);
+
+			out.intersection = point;
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS && RAY_CAST_BATCH_SSE2
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/randomization.h"
+
+TEST_CASE("RayCasts PolygonX4MatchesScalar") {
+	randomization rng(1337);
+
+	auto random_point = [&](const real32 range) {
+		return b2Vec2(rng.randval(-range, range), rng.randval(-range, range));
+	};
+
+	int hits = 0;
+
+	for (int iteration = 0; iteration < 5000; ++iteration) {
+		std::array<b2Vec2, b2_maxPolygonVertices> points;
+		const auto num_points = rng.randval(3, b2_maxPolygonVertices);
+
+		for (int i = 0; i < num_points; ++i) {
+			points[i] = random_point(2.f);
+		}
+
+		b2PolygonShape poly;
+		b2Transform xf;
+
+		if (iteration % 10 == 0) {
+			/* An axis-aligned box, so that rays along its edges are exactly parallel. */
+			poly.SetAsBox(1.f, 1.f);
+			xf.SetIdentity();
+		}
+		else {
+			poly.Set(points.data(), num_points);
+			xf.Set(random_point(5.f), rng.randval(0.f, 2 * b2_pi));
+		}
+
+		const auto p1 = random_point(8.f);
+
+		/* An edge of the polygon in world space. */
+		const auto edge = rng.randval(0, poly.m_count - 1);
+		const auto v0 = b2Mul(xf, poly.m_vertices[edge]);
+		const auto v1 = b2Mul(xf, poly.m_vertices[(edge + 1) % poly.m_count]);
+
+		std::array<b2Vec2, 4> starts;
+		std::array<b2Vec2, 4> ends;
+
+		/* Any ray. */
+		starts[0] = p1;
+		ends[0] = random_point(8.f);
+
+		/* Grazing a vertex. */
+		starts[1] = p1;
+		ends[1] = p1 + 2.f * (v0 - p1);
+
+		/* Along an edge. */
+		starts[2] = v0 + 3.f * (v0 - v1);
+		ends[2] = v1 + 3.f * (v1 - v0);
+
+		/* Parallel to an edge, on either side of it. */
+		const auto offset = rng.randval(-0.5f, 0.5f) * b2Mul(xf.q, poly.m_normals[edge]);
+		starts[3] = starts[2] + offset;
+		ends[3] = ends[2] + offset;
+
+		/* The kernel takes a common origin, so test every start against all four ends. */
+
+		for (const auto& origin : starts) {
+			const auto p1_local = b2MulT(xf.q, origin - xf.p);
+
+			std::array<float, 4> p2x;
+			std::array<float, 4> p2y;
+			std::array<float, 4> max_fractions;
+			std::array<float, 4> fractions;
+			std::array<int, 4> indices;
+
+			for (std::size_t k = 0; k < 4; ++k) {
+				p2x[k] = ends[k].x;
+				p2y[k] = ends[k].y;
+				max_fractions[k] = k == 0 ? rng.randval(0.2f, 1.f) : 1.f;
+			}
+
+			ray_cast_polygon_x4(poly, xf, p1_local, p2x.data(), p2y.data(), max_fractions.data(), fractions.data(), indices.data());
+
+			for (std::size_t k = 0; k < 4; ++k) {
+				b2RayCastInput input;
+				input.p1 = origin;
+				input.p2 = ends[k];
+				input.maxFraction = max_fractions[k];
+
+				b2RayCastOutput output;
+
+				const bool scalar_hit = poly.RayCast(&output, input, xf, 0);
+
+				REQUIRE(scalar_hit == (indices[k] >= 0));
+
+				if (scalar_hit) {
+					const auto normal = b2Mul(xf.q, poly.m_normals[indices[k]]);
+
+					REQUIRE(output.fraction == fractions[k]);
+					REQUIRE(output.normal.x == normal.x);
+					REQUIRE(output.normal.y == normal.y);
+
+					++hits;
+				}
+			}
+		}
+	}
+
+	/* Make sure that the comparison did not pass only because nothing was ever hit. */
+	REQUIRE(hits > 1000);
+}
+#endif
@@ -164,6 +164,9 @@ void standard_explosion_input::instantiate(
 
 	std::unordered_set<unversioned_entity_id> affected_entities_of_bodies;
 
+	thread_local std::vector<std::array<vec2, 3>> damaging_triangles;
+	damaging_triangles.clear();
+
 	for (auto i = 0u; i < response.get_num_triangles(); ++i) {
 		auto damaging_triangle = response.get_world_triangle(i, request.eye_transform.pos);
 		damaging_triangle[1] += (damaging_triangle[1] - damaging_triangle[0]).set_length(5);
@@ -173,14 +176,20 @@ void standard_explosion_input::instantiate(
 			continue;
 		}
 
-		physics.for_each_intersection_with_triangle(
+		damaging_triangles.push_back(damaging_triangle);
+	}
+
+	{
+		physics.for_each_intersection_with_triangles(
 			cosm.get_si(),
-			damaging_triangle,
+			damaging_triangles.data(),
+			damaging_triangles.size(),
 			predefined_queries::force_explosion(),
 			[&](
 				const b2Fixture& fix,
 				const vec2 point_a,
-				const vec2 point_b
+				const vec2 point_b,
+				const std::size_t
 			) {
 				(void)point_a;
 
@@ -255,6 +264,11 @@ void standard_explosion_input::instantiate(
 		);
 	}
 
+	/*
+		Not part of the batched query above: it uses another filter
+		and has to see which entities the damage pass has already affected.
+	*/
+
 	{
 		physics.for_each_intersection_with_circle_meters( 
 			si,
@@ -0,0 +1,152 @@
+#include <optional>
+
+#include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Collision/Shapes/b2PolygonShape.h>
+#include <Box2D/Collision/b2Collision.h>
+
+#include "game/inferred_caches/navmesh_cache.h"
+#include "game/inferred_caches/navmesh_cache.hpp"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/cosmos.h"
+#include "game/enums/filters.h"
+
+/* Beyond this, the cells get coarser so that huge maps do not exhaust memory. */
+constexpr std::size_t max_navmesh_cells_v = 1 << 22;
+
+void navmesh_cache::invalidate() {
+	built.reset();
+}
+
+void navmesh_cache::infer_all(const cosmos&) {
+	invalidate();
+}
+
+void navmesh_cache::infer_cache_for(const const_entity_handle& e) {
+	using concerned = entity_types_passing<concerned_with>;
+
+	e.constrained_dispatch<concerned>([this](const auto& typed_handle) {
+		specific_infer_cache_for(typed_handle);
+	});
+}
+
+void navmesh_cache::destroy_cache_of(const const_entity_handle& e) {
+	using concerned = entity_types_passing<concerned_with>;
+
+	e.constrained_dispatch<concerned>([this](const auto& typed_handle) {
+		if (::is_navmesh_obstacle(typed_handle)) {
+			invalidate();
+		}
+	});
+}
+
+static navmesh make_navmesh(const cosmos& cosm) {
+	const auto si = cosm.get_si();
+	const auto& settings = cosm.get_common_significant().pathfinding;
+	const auto& world = cosm.get_solvable_inferred().physics.get_b2world();
+	const auto filter = predefined_queries::pathfinding();
+
+	const auto for_each_obstacle = [&](auto callback) {
+		for (const b2Body* body = world.GetBodyList(); body != nullptr; body = body->GetNext()) {
+			if (body->GetType() != b2_staticBody) {
+				continue;
+			}
+
+			const auto& xf = body->GetTransform();
+
+			for (const b2Fixture* f = body->GetFixtureList(); f != nullptr; f = f->GetNext()) {
+				if (f->IsSensor() || !b2ContactFilter::ShouldCollide(&filter, &f->GetFilterData())) {
+					continue;
+				}
+
+				const auto& shape = *f->GetShape();
+
+				for (int32 child = 0; child < shape.GetChildCount(); ++child) {
+					b2AABB aabb;
+					shape.ComputeAABB(&aabb, xf, child);
+
+					callback(shape, child, xf, aabb);
+				}
+			}
+		}
+	};
+
+	const auto to_pixels = [&](const b2AABB& aabb) {
+		return ltrb(si.get_pixels(vec2(aabb.lowerBound)), si.get_pixels(vec2(aabb.upperBound - aabb.lowerBound)));
+	};
+
+	std::optional<ltrb> bounds;
+
+	for_each_obstacle([&](const b2Shape&, int32, const b2Transform&, const b2AABB& aabb) {
+		if (bounds) {
+			bounds->contain(to_pixels(aabb));
+		}
+		else {
+			bounds = to_pixels(aabb);
+		}
+	});
+
+	navmesh mesh;
+
+	if (!bounds) {
+		/* Nothing to walk around. An unset navmesh answers every query with a straight line. */
+		return mesh;
+	}
+
+	const auto radius = settings.navmesh_agent_radius;
+	auto cell_size = std::max(settings.navmesh_cell_size, 1.f);
+
+	/* Leave some room around the outermost walls so that paths can go around them. */
+	bounds->expand_from_center(vec2::square(radius + cell_size * 4));
+
+	while ((bounds->w() / cell_size) * (bounds->h() / cell_size) > static_cast<float>(max_navmesh_cells_v)) {
+		cell_size *= 2;
+	}
+
+	mesh.reset(*bounds, cell_size, settings.navmesh_cluster_cells);
+
+	/* A cell is blocked if an agent centered anywhere within it could touch an obstacle. */
+
+	const auto half_extent = si.get_meters(cell_size / 2 + radius);
+
+	b2PolygonShape cell_shape;
+	cell_shape.SetAsBox(half_extent, half_extent);
+
+	b2Transform cell_transform;
+	cell_transform.SetIdentity();
+
+	for_each_obstacle([&](const b2Shape& shape, const int32 child, const b2Transform& xf, const b2AABB& aabb) {
+		const auto lower = mesh.get_cell_at(si.get_pixels(vec2(aabb.lowerBound)) - vec2::square(radius));
+		const auto upper = mesh.get_cell_at(si.get_pixels(vec2(aabb.upperBound)) + vec2::square(radius));
+
+		for (int y = lower.y; y <= upper.y; ++y) {
+			for (int x = lower.x; x <= upper.x; ++x) {
+				const auto center = mesh.get_cell_center({ x, y });
+
+				if (!mesh.is_walkable_at(center)) {
+					continue;
+				}
+
+				cell_transform.p = b2Vec2(si.get_meters(center));
+
+				if (b2TestOverlap(&shape, child, &cell_shape, 0, xf, cell_transform)) {
+					mesh.mark_blocked({ x, y });
+				}
+			}
+		}
+	});
+
+	mesh.build_portals();
+
+	return mesh;
+}
+
+const navmesh& navmesh_cache::get_navmesh(const cosmos& cosm) const {
+	if (built == nullptr) {
+		auto scope = measure_scope(cosm.profiler.building_navmesh);
+		built = std::make_shared<const navmesh>(::make_navmesh(cosm));
+	}
+
+	return *built;
+}
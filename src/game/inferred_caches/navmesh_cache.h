@@ -0,0 +1,41 @@
+#pragma once
+#include <memory>
+
+#include "game/detail/ai/navmesh.h"
+
+#include "game/cosmos/entity_type_traits.h"
+#include "game/cosmos/entity_handle_declaration.h"
+
+class cosmos;
+
+/*
+	The navmesh is rasterized from static colliders lazily,
+	once some entity first needs a path.
+	Creating or destroying a static body only drops the navmesh,
+	so an arena that creates all of its walls at once builds it exactly once.
+
+	A built navmesh never changes,
+	so the copies of the cosmos (e.g. the predicted one) share it instead of copying it.
+*/
+
+class navmesh_cache {
+	mutable std::shared_ptr<const navmesh> built;
+
+	void invalidate();
+
+public:
+	template <class E>
+	struct concerned_with {
+		static constexpr bool value = has_all_of_v<E, invariants::rigid_body>;
+	};
+
+	void infer_all(const cosmos&);
+
+	template <class E>
+	void specific_infer_cache_for(const E&);
+
+	void infer_cache_for(const const_entity_handle&);
+	void destroy_cache_of(const const_entity_handle&);
+
+	const navmesh& get_navmesh(const cosmos&) const;
+};
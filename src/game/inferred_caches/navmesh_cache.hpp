@@ -0,0 +1,16 @@
+#pragma once
+#include "game/inferred_caches/navmesh_cache.h"
+#include "game/components/rigid_body_component.h"
+
+template <class E>
+bool is_navmesh_obstacle(const E& typed_handle) {
+	const auto type = typed_handle.template get<invariants::rigid_body>().body_type;
+	return type == rigid_body_type::STATIC || type == rigid_body_type::ALWAYS_STATIC;
+}
+
+template <class E>
+void navmesh_cache::specific_infer_cache_for(const E& typed_handle) {
+	if (::is_navmesh_obstacle(typed_handle)) {
+		invalidate();
+	}
+}
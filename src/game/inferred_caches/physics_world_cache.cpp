@@ -205,17 +205,198 @@ physics_world_cache& physics_world_cache::operator=(const physics_world_cache&)
 	return *this;
 }
 
-void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
-	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
-	ensure(this != std::addressof(source_cache));
+static bool shapes_equal(const b2Shape& a, const b2Shape& b) {
+	if (a.m_type != b.m_type || a.m_radius != b.m_radius) {
+		return false;
+	}
 
-	accumulated_messages = source_cache.accumulated_messages;
+	if (a.m_type == b2Shape::e_circle) {
+		return static_cast<const b2CircleShape&>(a).m_p == static_cast<const b2CircleShape&>(b).m_p;
+	}
+
+	if (a.m_type == b2Shape::e_polygon) {
+		const auto& pa = static_cast<const b2PolygonShape&>(a);
+		const auto& pb = static_cast<const b2PolygonShape&>(b);
+
+		if (pa.m_count != pb.m_count || !(pa.m_centroid == pb.m_centroid)) {
+			return false;
+		}
+
+		for (int32 i = 0; i < pa.m_count; ++i) {
+			if (!(pa.m_vertices[i] == pb.m_vertices[i]) || !(pa.m_normals[i] == pb.m_normals[i])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+	True if both worlds have the same bodies with the same fixtures in the same order.
+	This holds when one was cloned from an earlier state of the other's simulation,
+	and no entity with physics was created, destroyed or reshaped since.
+*/
+
+static bool have_same_bodies(const b2World& a, const b2World& b) {
+	if (a.m_bodyCount != b.m_bodyCount || a.m_jointCount != 0 || b.m_jointCount != 0) {
+		return false;
+	}
+
+	const b2Body* ba = a.m_bodyList;
+	const b2Body* bb = b.m_bodyList;
+
+	for (; ba && bb; ba = ba->m_next, bb = bb->m_next) {
+		if (!(ba->m_userData == bb->m_userData) || ba->m_fixtureCount != bb->m_fixtureCount) {
+			return false;
+		}
+
+		const b2Fixture* fa = ba->m_fixtureList;
+		const b2Fixture* fb = bb->m_fixtureList;
+
+		for (; fa && fb; fa = fa->m_next, fb = fb->m_next) {
+			if (
+				!(fa->m_userData == fb->m_userData)
+				|| fa->index_in_component != fb->index_in_component
+				|| fa->m_proxyCount != fb->m_proxyCount
+				|| !shapes_equal(*fa->m_shape, *fb->m_shape)
+			) {
+				return false;
+			}
+		}
+
+		if (fa || fb) {
+			return false;
+		}
+	}
+
+	return ba == nullptr && bb == nullptr;
+}
+
+/*
+	Copies the source world into the migrated one, noting where every pointer of the source went.
+
+	If both worlds have the same bodies, e.g. when repredicting from the same referential state many times over,
+	the bodies and fixtures are synced in place and only the contacts and the broadphase are copied.
+	Otherwise the migrated world is rebuilt from scratch.
+*/
+
+void physics_world_cache::clone_b2World(
+	b2World& migrated_b2World,
+	const b2World& source_b2World,
+	std::unordered_map<const void*, void*>& pointer_migrations
+) {
+	const bool sync_in_place = have_same_bodies(migrated_b2World, source_b2World);
+
+	pointer_migrations.clear();
+
+	{
+		const auto num_bodies = static_cast<std::size_t>(source_b2World.m_bodyCount);
+		const auto num_contacts = static_cast<std::size_t>(source_b2World.m_contactManager.m_contactCount);
+		const auto num_joints = static_cast<std::size_t>(source_b2World.m_jointCount);
+
+		/* Roughly: every body with its fixture, proxy and shape, plus contacts and joints. */
+		pointer_migrations.reserve(num_bodies * 4 + num_contacts + num_joints);
+	}
+
+	if (sync_in_place) {
+		/* Contacts come and go every step, so they are always copied anew. */
+
+		for (b2Contact* c = migrated_b2World.m_contactManager.m_contactList; c;) {
+			b2Contact* const next = c->m_next;
+
+			c->~b2Contact();
+			migrated_b2World.m_blockAllocator.Free(c, sizeof(b2Contact));
+
+			c = next;
+		}
+
+		{
+			b2Body* synced = migrated_b2World.m_bodyList;
 
-	b2World& migrated_b2World = *b2world.get();
-	migrated_b2World.~b2World();
-	new (&migrated_b2World) b2World(b2Vec2(0.f, 0.f));
+			for (const b2Body* b = source_b2World.m_bodyList; b; b = b->m_next, synced = synced->m_next) {
+				pointer_migrations.emplace(b, synced);
 
-	const b2World& source_b2World = *source_cache.b2world.get();
+				b2Fixture* synced_f = synced->m_fixtureList;
+
+				for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next, synced_f = synced_f->m_next) {
+					pointer_migrations.emplace(f, synced_f);
+				}
+			}
+		}
+
+		b2Body* synced = migrated_b2World.m_bodyList;
+
+		for (const b2Body* b = source_b2World.m_bodyList; b; b = b->m_next, synced = synced->m_next) {
+			b2Body* const prev = synced->m_prev;
+			b2Body* const next = synced->m_next;
+			b2Fixture* const fixtures = synced->m_fixtureList;
+
+			std::memcpy(static_cast<void*>(synced), b, sizeof(b2Body));
+
+			synced->m_prev = prev;
+			synced->m_next = next;
+			synced->m_fixtureList = fixtures;
+			synced->m_world = &migrated_b2World;
+			synced->m_jointList = nullptr;
+
+			if (b->m_ownerFrictionGround) {
+				synced->m_ownerFrictionGround = reinterpret_cast<b2Body*>(pointer_migrations.at(b->m_ownerFrictionGround));
+			}
+
+			b2Fixture* synced_f = synced->m_fixtureList;
+
+			for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next, synced_f = synced_f->m_next) {
+				b2Fixture* const next_f = synced_f->m_next;
+				b2Shape* const shape = synced_f->m_shape;
+				b2FixtureProxy* const proxies = synced_f->m_proxies;
+
+				std::memcpy(static_cast<void*>(synced_f), f, sizeof(b2Fixture));
+
+				synced_f->m_next = next_f;
+				synced_f->m_body = synced;
+				synced_f->m_shape = shape;
+				synced_f->m_proxies = proxies;
+
+				for (std::size_t i = 0; i < f->m_proxyCount; ++i) {
+					proxies[i] = f->m_proxies[i];
+					proxies[i].fixture = synced_f;
+				}
+			}
+		}
+	}
+	else {
+		/*
+			The chunks of the old block allocator are recycled,
+			so that a clone does not return and re-request the whole world's memory from the heap.
+		*/
+
+		for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
+			/* Shapes might own memory outside of the block allocator, so destroy them just like ~b2World does. */
+
+			b2Fixture* f = b->m_fixtureList;
+
+			while (f) {
+				b2Fixture* const next = f->m_next;
+				f->m_proxyCount = 0;
+				f->Destroy(&migrated_b2World.m_blockAllocator);
+				f = next;
+			}
+
+			b->m_fixtureList = nullptr;
+		}
+
+		b2BlockAllocator recycled_chunks;
+		recycled_chunks.Swap(migrated_b2World.m_blockAllocator);
+
+		migrated_b2World.~b2World();
+		new (&migrated_b2World) b2World(b2Vec2(0.f, 0.f));
+
+		migrated_b2World.m_blockAllocator.Swap(recycled_chunks);
+		migrated_b2World.m_blockAllocator.FreeAll();
+	}
 
 #if DEBUG_PHYSICS_SYSTEM_COPY
 	ensure_eq(0, source_b2World.m_stackAllocator.m_entryCount);
@@ -224,10 +405,16 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 
 	ensure_eq(static_cast<const b2ContactListener*>(source_b2World.m_contactManager.m_contactListener), &source_b2World.defaultListener);
 
+	b2Body* const synced_bodies = migrated_b2World.m_bodyList;
+
 	// do the initial trivial copy of all fields,
 	// we will migrate all pointers shortly
 	migrated_b2World = source_b2World;
 
+	if (sync_in_place) {
+		migrated_b2World.m_bodyList = synced_bodies;
+	}
+
 	{
 #if DEBUG_PHYSICS_SYSTEM_COPY
 		ensure_eq(0, migrated_b2World.m_stackAllocator.m_entryCount);
@@ -255,9 +442,19 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 	migrated_b2World.m_contactManager.m_contactFilter = &migrated_b2World.defaultFilter;
 	migrated_b2World.m_contactManager.m_contactListener = &migrated_b2World.defaultListener;
 
-	std::unordered_map<const void*, void*> pointer_migrations;
-	std::unordered_map<const void*, bool> contact_edge_a_or_b_in_contacts;
-	std::unordered_map<const void*, bool> joint_edge_a_or_b_in_joints;
+	thread_local std::unordered_map<const void*, bool> contact_edge_a_or_b_in_contacts;
+	thread_local std::unordered_map<const void*, bool> joint_edge_a_or_b_in_joints;
+
+	contact_edge_a_or_b_in_contacts.clear();
+	joint_edge_a_or_b_in_joints.clear();
+
+	{
+		const auto num_contacts = static_cast<std::size_t>(source_b2World.m_contactManager.m_contactCount);
+		const auto num_joints = static_cast<std::size_t>(source_b2World.m_jointCount);
+
+		contact_edge_a_or_b_in_contacts.reserve(num_contacts * 2);
+		joint_edge_a_or_b_in_joints.reserve(num_joints * 2);
+	}
 
 	b2BlockAllocator& migrated_allocator = migrated_b2World.m_blockAllocator;
 
@@ -472,50 +669,64 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 
 	auto& proxy_tree = migrated_b2World.m_contactManager.m_broadPhase.m_tree;
 
-	// migrate bodies and fixtures
-	migrate_pointer(migrated_b2World.m_bodyList);
+	if (sync_in_place) {
+		for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
+			/* Still points to the contact edges of the source body. */
+			migrate_contact_edge(b->m_contactList);
 
-	for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
-		migrate_pointer(b->m_fixtureList);
-		migrate_pointer(b->m_prev);
-		migrate_pointer(b->m_next);
-		migrate_pointer(b->m_ownerFrictionGround);
-
-		migrate_contact_edge(b->m_contactList);
-		migrate_joint_edge(b->m_jointList);
-		b->m_world = &migrated_b2World;
+			for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next) {
+				for (std::size_t i = 0; i < f->m_proxyCount; ++i) {
+					proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData = f->m_proxies + i;
+				}
+			}
+		}
+	}
+	else {
+		// migrate bodies and fixtures
+		migrate_pointer(migrated_b2World.m_bodyList);
+
+		for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
+			migrate_pointer(b->m_fixtureList);
+			migrate_pointer(b->m_prev);
+			migrate_pointer(b->m_next);
+			migrate_pointer(b->m_ownerFrictionGround);
+
+			migrate_contact_edge(b->m_contactList);
+			migrate_joint_edge(b->m_jointList);
+			b->m_world = &migrated_b2World;
 		
-		/*
-			b->m_fixtureList is already migrated.
-			f->m_next will also be always migrated before the next iteration
-			thus f is always already a migrated instance.
-		*/
-
-		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next) {
-			f->m_body = b;
+			/*
+				b->m_fixtureList is already migrated.
+				f->m_next will also be always migrated before the next iteration
+				thus f is always already a migrated instance.
+			*/
+
+			for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next) {
+				f->m_body = b;
 			
-			migrate_pointer(f->m_proxies, f->m_proxyCount);
-			f->m_shape = f->m_shape->Clone(&migrated_allocator);
-			migrate_pointer(f->m_next);
+				migrate_pointer(f->m_proxies, f->m_proxyCount);
+				f->m_shape = f->m_shape->Clone(&migrated_allocator);
+				migrate_pointer(f->m_next);
 
-			for (std::size_t i = 0; i < f->m_proxyCount; ++i) {
+				for (std::size_t i = 0; i < f->m_proxyCount; ++i) {
 #if DEBUG_PHYSICS_SYSTEM_COPY
-				/* 
-					"fixture" field of b2FixtureProxy should point to the fixture itself,
-					thus its value should already be found in the pointer map. 
-				*/
+					/* 
+						"fixture" field of b2FixtureProxy should point to the fixture itself,
+						thus its value should already be found in the pointer map. 
+					*/
 
-				ensure(pointer_migrations.find(f->m_proxies[i].fixture) != pointer_migrations.end())
+					ensure(pointer_migrations.find(f->m_proxies[i].fixture) != pointer_migrations.end())
 
-				{
-					const auto ff = pointer_migrations[f->m_proxies[i].fixture];
-					ensure_eq(reinterpret_cast<void*>(f), ff);
-				}
+					{
+						const auto ff = pointer_migrations[f->m_proxies[i].fixture];
+						ensure_eq(reinterpret_cast<void*>(f), ff);
+					}
 #endif
-				f->m_proxies[i].fixture = f;
+					f->m_proxies[i].fixture = f;
 				
-				void*& ud = proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData;
-				ud = pointer_migrations.at(ud);
+					void*& ud = proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData;
+					ud = pointer_migrations.at(ud);
+				}
 			}
 		}
 	}
@@ -526,6 +737,27 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		inside the loop that migrated all bodies and fixtures.
 	*/
 
+#if DEBUG_PHYSICS_SYSTEM_COPY
+	if (!sync_in_place) {
+		// ensure that all allocations have been migrated
+
+		ensure_eq(
+			migrated_allocator.m_numAllocatedObjects, 
+			source_b2World.m_blockAllocator.m_numAllocatedObjects
+		);
+	}
+#endif
+}
+
+void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
+	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
+	ensure(this != std::addressof(source_cache));
+
+	accumulated_messages = source_cache.accumulated_messages;
+
+	thread_local std::unordered_map<const void*, void*> pointer_migrations;
+	clone_b2World(*b2world.get(), *source_cache.b2world.get(), pointer_migrations);
+
 	target_cosm.for_each_having<invariants::fixtures>(
 		[&](const auto& typed_collider) {
 			const auto id = typed_collider.get_id();
@@ -580,13 +812,99 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		}
 	}
 #endif
+}
 
-#if DEBUG_PHYSICS_SYSTEM_COPY
-	// ensure that all allocations have been migrated
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
 
-	ensure_eq(
-		migrated_allocator.m_numAllocatedObjects, 
-		source_b2World.m_blockAllocator.m_numAllocatedObjects
-	);
-#endif
+TEST_CASE("PhysicsWorldCache SyncInPlaceMatchesRebuild") {
+	auto make_world = []() {
+		auto world = std::make_unique<b2World>(b2Vec2(0.f, 0.f));
+		world->SetAllowSleeping(true);
+		world->SetAutoClearForces(false);
+		return world;
+	};
+
+	auto simulate = [](b2World& world, const int steps) {
+		for (int i = 0; i < steps; ++i) {
+			world.Step(1.f / 60, 8, 3);
+			world.ClearForces();
+		}
+	};
+
+	auto source = make_world();
+
+	{
+		b2PolygonShape box;
+		box.SetAsBox(0.5f, 0.5f);
+
+		b2CircleShape circle;
+		circle.m_radius = 0.4f;
+
+		for (unsigned i = 0; i < 40; ++i) {
+			b2BodyDef def;
+			def.type = i % 10 == 0 ? b2_staticBody : b2_dynamicBody;
+			def.transform.p.Set(static_cast<float>(i % 8) * 1.2f, static_cast<float>(i / 8) * 1.2f);
+			def.sweep.localCenter.SetZero();
+			def.sweep.c0 = def.sweep.c = def.transform.p;
+			def.sweep.a0 = def.sweep.a = 0.f;
+			def.sweep.alpha0 = 0.f;
+			def.linearVelocity.Set(static_cast<float>(i % 3) - 1.f, static_cast<float>(i % 5) - 2.f);
+			def.angularVelocity = static_cast<float>(i % 4) * 0.5f;
+			def.userData.raw.indirection_index = i;
+
+			b2FixtureDef fixdef;
+			fixdef.shape = i % 2 ? static_cast<const b2Shape*>(&box) : &circle;
+			fixdef.density = 1.f;
+			fixdef.friction = 0.3f;
+
+			source->CreateBody(&def)->CreateFixture(&fixdef);
+		}
+	}
+
+	std::unordered_map<const void*, void*> pointer_migrations;
+
+	simulate(*source, 30);
+
+	auto synced = make_world();
+	physics_world_cache::clone_b2World(*synced, *source, pointer_migrations);
+
+	/* Let both go their own way, so that the synced world is stale, just like a predicted one. */
+	simulate(*source, 30);
+	simulate(*synced, 10);
+
+	REQUIRE(source->GetContactCount() > 0);
+	REQUIRE(have_same_bodies(*synced, *source));
+
+	auto rebuilt = make_world();
+
+	physics_world_cache::clone_b2World(*synced, *source, pointer_migrations);
+	physics_world_cache::clone_b2World(*rebuilt, *source, pointer_migrations);
+
+	REQUIRE(synced->GetContactCount() == source->GetContactCount());
+
+	simulate(*source, 60);
+	simulate(*synced, 60);
+	simulate(*rebuilt, 60);
+
+	const b2Body* s = source->GetBodyList();
+	const b2Body* a = synced->GetBodyList();
+	const b2Body* b = rebuilt->GetBodyList();
+
+	for (; s; s = s->GetNext(), a = a->GetNext(), b = b->GetNext()) {
+		REQUIRE(a != nullptr);
+		REQUIRE(b != nullptr);
+
+		for (const b2Body* c : { a, b }) {
+			REQUIRE(c->GetPosition() == s->GetPosition());
+			REQUIRE(c->GetAngle() == s->GetAngle());
+			REQUIRE(c->GetLinearVelocity() == s->GetLinearVelocity());
+			REQUIRE(c->GetAngularVelocity() == s->GetAngularVelocity());
+		}
+	}
+
+	REQUIRE(a == nullptr);
+	REQUIRE(b == nullptr);
+	REQUIRE(synced->GetContactCount() == source->GetContactCount());
 }
+#endif
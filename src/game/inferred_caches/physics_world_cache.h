@@ -1,4 +1,6 @@
 #pragma once
+#include <unordered_map>
+
 #include "3rdparty/Box2D/Dynamics/b2Filter.h"
 #include "augs/misc/constant_size_vector.h"
 #include "augs/templates/propagate_const.h"
@@ -77,6 +79,12 @@ public:
 
 	void clone_from(const physics_world_cache& source_world, cosmos& target_cosmos, const cosmos& source_cosmos);
 
+	static void clone_b2World(
+		b2World& migrated_b2World, 
+		const b2World& source_b2World, 
+		std::unordered_map<const void*, void*>& pointer_migrations
+	);
+
 	std::vector<physics_raycast_output> ray_cast_all_intersections(
 		const vec2 p1_meters,
 		const vec2 p2_meters, 
@@ -91,6 +99,21 @@ public:
 		const entity_id ignore_entity = entity_id()
 	) const;
 
+	/*
+		Casts rays from a common origin against the fixtures in range,
+		testing four rays at a time instead of traversing the broadphase per ray.
+		Hits and intersections match ray_cast, except that when two fixtures
+		are hit within float rounding of each other, the closer of the two may differ.
+	*/
+
+	void ray_cast_batch(
+		const vec2 origin_meters,
+		const std::vector<vec2>& destinations_meters,
+		const b2Filter filter,
+		const entity_id ignore_entity,
+		std::vector<physics_raycast_output>& outputs
+	) const;
+
 	physics_raycast_output ray_cast_px(
 		const si_scaling si,
 		const vec2 p1, 
@@ -124,6 +147,11 @@ public:
 		::for_each_in_aabb_meters(get_b2world(), std::forward<Args>(args)...);
 	}
 
+	template <class... Args>
+	void for_each_in_aabbs_meters(Args&&... args) const {
+		::for_each_in_aabbs_meters(get_b2world(), std::forward<Args>(args)...);
+	}
+
 	template <class... Args>
 	void for_each_intersection_with_shape_meters(Args&&... args) const {
 		::for_each_intersection_with_shape_meters(get_b2world(), std::forward<Args>(args)...);
@@ -154,6 +182,11 @@ public:
 		::for_each_intersection_with_triangle(get_b2world(), std::forward<Args>(args)...);
 	}
 
+	template <class... Args>
+	void for_each_intersection_with_triangles(Args&&... args) const {
+		::for_each_intersection_with_triangles(get_b2world(), std::forward<Args>(args)...);
+	}
+
 	template <class... Args>
 	void for_each_intersection_with_polygon(Args&&... args) const {
 		::for_each_intersection_with_polygon(get_b2world(), std::forward<Args>(args)...);
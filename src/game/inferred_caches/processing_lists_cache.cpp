@@ -1,4 +1,3 @@
-#include "augs/templates/container_templates.h"
 #include "augs/templates/enum_introspect.h"
 
 #include "game/cosmos/cosmos.h"
@@ -7,6 +6,33 @@
 #include "game/inferred_caches/processing_lists_cache.hpp"
 #include "game/cosmos/for_each_entity.h"
 
+void processing_list::add(const entity_id id) {
+	const auto new_index = static_cast<unsigned>(subjects.size());
+
+	if (index_of.try_emplace(id, new_index).second) {
+		subjects.push_back(id);
+	}
+}
+
+void processing_list::remove(const entity_id id) {
+	const auto it = index_of.find(id);
+
+	if (it == index_of.end()) {
+		return;
+	}
+
+	const auto removed_index = it->second;
+	index_of.erase(it);
+
+	const auto last = subjects.back();
+	subjects.pop_back();
+
+	if (removed_index < subjects.size()) {
+		subjects[removed_index] = last;
+		index_of[last] = removed_index;
+	}
+}
+
 void processing_lists_cache::infer_all(const cosmos& cosm) {
 	cosm.for_each_entity(
 		[&](const auto& typed_handle) {
@@ -21,7 +47,7 @@ void processing_lists_cache::destroy_cache_of(const const_entity_handle& handle)
 
 	augs::for_each_enum_except_bounds([&](const processing_subjects key) {
 		if (old_flags.test(key)) {
-			erase_element(lists[key], id);
+			lists[key].remove(id);
 		}
 	});
 }
@@ -39,5 +65,5 @@ void processing_lists_cache::reserve_caches_for_entities(std::size_t) {
 }
 
 const std::vector<entity_id>& processing_lists_cache::get(const processing_subjects list) const {
-	return lists[list];
+	return lists[list].get();
 }
\ No newline at end of file
@@ -8,13 +8,39 @@
 
 #include "game/cosmos/entity_id.h"
 #include "game/cosmos/entity_handle_declaration.h"
+#include "game/inferred_caches/inferred_cache_common.h"
 
 using all_processing_flags = augs::enum_boolset<processing_subjects>;
 
 class cosmos;
 
+/*
+	A dense list of subjects with the position of each subject stored alongside,
+	so that both adding and removing a subject is O(1).
+
+	Removal moves the last subject into the freed slot.
+	The order is thus not canonical, but it is a pure function of the sequence of add/remove calls,
+	so two cosmoi that infer and destroy the same entities in the same order iterate identically.
+	Right after infer_all, the order is that of cosmos::for_each_entity.
+
+	Logic whose outcome depends on the order of iteration must not assume anything more than that.
+*/
+
+class processing_list {
+	std::vector<entity_id> subjects;
+	inferred_cache_map<unsigned> index_of;
+
+public:
+	void add(entity_id);
+	void remove(entity_id);
+
+	const auto& get() const {
+		return subjects;
+	}
+};
+
 class processing_lists_cache {
-	augs::enum_array<std::vector<entity_id>, processing_subjects> lists;
+	augs::enum_array<processing_list, processing_subjects> lists;
 
 public:
 	template <class E>
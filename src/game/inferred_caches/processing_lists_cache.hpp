@@ -20,7 +20,7 @@ void processing_lists_cache::specific_infer_cache_for(const E& typed_handle) {
 
 	augs::for_each_enum_except_bounds([&](const processing_subjects key) {
 		if (new_flags.test(key)) {
-			lists[key].push_back(id);
+			lists[key].add(id);
 		}
 	});
 }
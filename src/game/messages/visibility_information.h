@@ -10,7 +10,15 @@
 
 struct visibility_information_request_input {
 	b2Filter filter;
-	pad_bytes<2> pad;
+
+	/*
+		Cast all rays through physics_world_cache::ray_cast_batch.
+		Faster, but may resolve near-ties between obstacles differently than per-ray casts,
+		so only requests that do not affect the game logic should set it.
+	*/
+
+	bool batch_raycasts = false;
+	pad_bytes<1> pad;
 
 	vec2 queried_rect;
 	float ignore_discontinuities_shorter_than = -1.f;
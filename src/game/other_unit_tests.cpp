@@ -13,6 +13,77 @@
 #include "game/components/transform_component.h"
 #include "game/components/rigid_body_component.h"
 
+#include "augs/misc/randomization.h"
+#include "game/detail/physics/physics_queries.h"
+
+/*
+	Explosion fans reaching into a small crowded world.
+	The batched query has to report exactly what the single queries report, in the same order.
+*/
+
+TEST_CASE("Physics BatchedTriangleQueriesMatchSingleQueries") {
+	b2World world(b2Vec2(0.f, 0.f));
+	const auto si = si_scaling();
+
+	auto rng = randomization(1337);
+
+	for (int i = 0; i < 400; ++i) {
+		b2BodyDef def;
+		def.transform.SetIdentity();
+
+		if (i > 0) {
+			def.transform.p.Set(rng.randval(-30.f, 30.f), rng.randval(-30.f, 30.f));
+		}
+
+		b2PolygonShape shape;
+		shape.SetAsBox(0.5f, 0.5f);
+
+		b2FixtureDef fixture_def;
+		fixture_def.shape = &shape;
+
+		world.CreateBody(&def)->CreateFixture(&fixture_def);
+	}
+
+	std::vector<std::array<vec2, 3>> triangles;
+
+	const auto num_explosions = 6;
+	const auto triangles_per_explosion = 32;
+
+	for (int e = 0; e < num_explosions; ++e) {
+		/* The first one is centered on the body at the origin, so that there is always a hit. */
+		const auto center = e == 0 ? vec2::zero : vec2(rng.randval(-3000.f, 3000.f), rng.randval(-3000.f, 3000.f));
+
+		for (int i = 0; i < triangles_per_explosion; ++i) {
+			const auto a = vec2::from_degrees(i * 360.f / triangles_per_explosion);
+			const auto b = vec2::from_degrees((i + 1) * 360.f / triangles_per_explosion);
+
+			triangles.push_back({ center, center + a * 500.f, center + b * 500.f });
+		}
+	}
+
+	using hit = std::pair<const b2Fixture*, std::size_t>;
+
+	std::vector<hit> single_hits;
+	std::vector<hit> batched_hits;
+
+	const auto filter = b2Filter();
+
+	for (std::size_t i = 0; i < triangles.size(); ++i) {
+		for_each_intersection_with_triangle(world, si, triangles[i], filter, [&](const b2Fixture& f, vec2, vec2) {
+			single_hits.emplace_back(std::addressof(f), i);
+			return callback_result::CONTINUE;
+		});
+	}
+
+	for_each_intersection_with_triangles(world, si, triangles.data(), triangles.size(), filter, [&](const b2Fixture& f, vec2, vec2, const std::size_t i) {
+		batched_hits.emplace_back(std::addressof(f), i);
+		return callback_result::CONTINUE;
+	});
+
+	REQUIRE(single_hits.size() > 0);
+	REQUIRE(single_hits == batched_hits);
+}
+
 #if !STATICALLY_ALLOCATE_ENTITIES
 
 TEST_CASE("LogicallyEmpty") {
@@ -1,8 +1,22 @@
 #pragma once
-class cosmos;
+#include "augs/math/vec2.h"
 #include "game/cosmos/step_declaration.h"
 
+class cosmos;
+class navmesh;
+
+namespace components {
+	struct pathfinding;
+}
+
+/*
+	Advances the session of a single agent standing at pos.
+	Returns false once the session is over - either the target was reached or there is no way to it.
+*/
+
+bool advance_pathfinding_session(components::pathfinding&, vec2 pos, const navmesh&);
+
 class pathfinding_system {
 public:
 	void advance_pathfinding_sessions(const logic_step);
-};
\ No newline at end of file
+};
@@ -598,16 +598,30 @@ void visibility_system::calc_visibility(
 	all_ray_outputs.reserve(all_vertices_transformed.size());
 
 	/* All raycast inputs are processed at once to improve cache coherency. */
-	for (std::size_t j = 0; j < all_ray_inputs.size(); ++j) {
-		auto result = physics.ray_cast(eye_meters, all_ray_inputs[j].destination, request.filter, ignored_entity);
-		all_ray_outputs.emplace_back(std::move(result));
+	if (request.batch_raycasts) {
+		thread_local std::vector<vec2> all_ray_destinations;
+		all_ray_destinations.clear();
+
+		for (const auto& r : all_ray_inputs) {
+			all_ray_destinations.push_back(r.destination);
+		}
+
+		physics.ray_cast_batch(eye_meters, all_ray_destinations, request.filter, ignored_entity, all_ray_outputs);
+	}
+	else {
+		for (std::size_t j = 0; j < all_ray_inputs.size(); ++j) {
+			auto result = physics.ray_cast(eye_meters, all_ray_inputs[j].destination, request.filter, ignored_entity);
+			all_ray_outputs.emplace_back(std::move(result));
+		}
+	}
 
 #if LOG_VISIBILITY
-		if (DEBUG_DRAWING.draw_cast_rays) {
-			draw_line(all_ray_inputs[j].destination, pink);
+	if (DEBUG_DRAWING.draw_cast_rays) {
+		for (const auto& r : all_ray_inputs) {
+			draw_line(r.destination, pink);
 		}
-#endif
 	}
+#endif
 
 	for (std::size_t i = 0; i < all_ray_outputs.size(); ++i) {
 		const auto& ray_callback = all_ray_outputs[i];
@@ -0,0 +1,201 @@
+#include <cmath>
+#include <algorithm>
+
+#include "view/audiovisual_state/general_particles_soa.h"
+
+template <class F>
+void general_particles_soa::for_each_array(F&& callback) {
+	callback(pos_x);
+	callback(pos_y);
+	callback(vel_x);
+	callback(vel_y);
+	callback(acc_x);
+	callback(acc_y);
+
+	callback(rotation);
+	callback(rotation_speed);
+
+	callback(linear_damping);
+	callback(angular_damping);
+
+	callback(current_lifetime_ms);
+	callback(max_lifetime_ms);
+
+	callback(appearances);
+}
+
+void general_particles_soa::clear() {
+	for_each_array([](auto& v) { v.clear(); });
+}
+
+void general_particles_soa::push_back(const general_particle& p) {
+	pos_x.push_back(p.pos.x);
+	pos_y.push_back(p.pos.y);
+	vel_x.push_back(p.vel.x);
+	vel_y.push_back(p.vel.y);
+	acc_x.push_back(p.acc.x);
+	acc_y.push_back(p.acc.y);
+
+	rotation.push_back(p.rotation);
+	rotation_speed.push_back(p.rotation_speed);
+
+	linear_damping.push_back(p.linear_damping);
+	angular_damping.push_back(p.angular_damping);
+
+	current_lifetime_ms.push_back(p.current_lifetime_ms);
+	max_lifetime_ms.push_back(p.max_lifetime_ms);
+
+	appearances.push_back({
+		p.image_id,
+		p.color,
+		p.size,
+		p.shrink_when_ms_remaining,
+		p.unshrinking_time_ms,
+		p.alpha_levels
+	});
+}
+
+general_particle general_particles_soa::get(const std::size_t i) const {
+	general_particle p;
+
+	p.pos = { pos_x[i], pos_y[i] };
+	p.vel = { vel_x[i], vel_y[i] };
+	p.acc = { acc_x[i], acc_y[i] };
+
+	p.rotation = rotation[i];
+	p.rotation_speed = rotation_speed[i];
+
+	p.linear_damping = linear_damping[i];
+	p.angular_damping = angular_damping[i];
+
+	p.current_lifetime_ms = current_lifetime_ms[i];
+	p.max_lifetime_ms = max_lifetime_ms[i];
+
+	const auto& a = appearances[i];
+
+	p.image_id = a.image_id;
+	p.color = a.color;
+	p.size = a.size;
+	p.shrink_when_ms_remaining = a.shrink_when_ms_remaining;
+	p.unshrinking_time_ms = a.unshrinking_time_ms;
+	p.alpha_levels = a.alpha_levels;
+
+	return p;
+}
+
+void general_particles_soa::integrate(const std::size_t from, const std::size_t to, const float dt) {
+	/*
+		Mirrors generic_integrate_particle,
+		with vec2::shrink and augs::shrink rewritten without branches.
+	*/
+
+	float* const px = pos_x.data();
+	float* const py = pos_y.data();
+	float* const vx = vel_x.data();
+	float* const vy = vel_y.data();
+	const float* const ax = acc_x.data();
+	const float* const ay = acc_y.data();
+
+	for (std::size_t i = from; i < to; ++i) {
+		const auto new_vx = vx[i] + ax[i] * dt;
+		const auto new_vy = vy[i] + ay[i] * dt;
+
+		px[i] += new_vx * dt;
+		py[i] += new_vy * dt;
+
+		const auto shrunk_by = linear_damping[i] * dt;
+		const auto len = std::sqrt(new_vx * new_vx + new_vy * new_vy);
+		const auto scale = std::max(len - shrunk_by, 0.f) / std::max(len, 1e-30f);
+
+		vx[i] = new_vx * scale;
+		vy[i] = new_vy * scale;
+	}
+
+	const auto dt_ms = dt * 1000;
+
+	for (std::size_t i = from; i < to; ++i) {
+		current_lifetime_ms[i] += dt_ms;
+	}
+
+	for (std::size_t i = from; i < to; ++i) {
+		rotation[i] += rotation_speed[i] * dt;
+
+		const auto s = rotation_speed[i];
+		rotation_speed[i] = std::copysign(std::max(std::abs(s) - angular_damping[i] * dt, 0.f), s);
+	}
+}
+
+void general_particles_soa::remove_dead() {
+	const auto n = size();
+	std::size_t alive_n = 0;
+
+	for (std::size_t i = 0; i < n; ++i) {
+		if (current_lifetime_ms[i] >= max_lifetime_ms[i]) {
+			continue;
+		}
+
+		if (alive_n != i) {
+			for_each_array([i, alive_n](auto& v) { v[alive_n] = v[i]; });
+		}
+
+		++alive_n;
+	}
+
+	for_each_array([alive_n](auto& v) { v.resize(alive_n); });
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/templates/container_templates.h"
+#include "view/viewables/particle_types.hpp"
+
+TEST_CASE("GeneralParticlesSoa IntegratesLikeSingleParticles") {
+	std::vector<general_particle> reference;
+	general_particles_soa soa;
+
+	for (int i = 0; i < 37; ++i) {
+		general_particle p;
+
+		p.pos = vec2(float(i * 3), float(-i));
+		p.vel = vec2(float(100 - i * 7), float(i * 5 - 40));
+		p.acc = vec2(float(i % 5), -float(i % 3));
+		p.rotation = float(i * 10);
+		p.rotation_speed = float(i * 13 - 200);
+		p.linear_damping = float(i * 20);
+		p.angular_damping = float(i * 4);
+		p.max_lifetime_ms = float(50 + i * 20);
+
+		reference.push_back(p);
+		soa.push_back(p);
+	}
+
+	const auto dt = 1 / 60.f;
+
+	for (int step = 0; step < 30; ++step) {
+		for (auto& p : reference) {
+			p.integrate(dt);
+		}
+
+		soa.integrate(0, soa.size() / 2, dt);
+		soa.integrate(soa.size() / 2, soa.size(), dt);
+
+		erase_if(reference, [](const auto& p) { return p.is_dead(); });
+		soa.remove_dead();
+
+		REQUIRE(soa.size() == reference.size());
+
+		for (std::size_t i = 0; i < reference.size(); ++i) {
+			const auto& r = reference[i];
+			const auto s = soa.get(i);
+
+			REQUIRE(s.pos.x == Approx(r.pos.x).margin(0.01));
+			REQUIRE(s.pos.y == Approx(r.pos.y).margin(0.01));
+			REQUIRE(s.vel.x == Approx(r.vel.x).margin(0.01));
+			REQUIRE(s.vel.y == Approx(r.vel.y).margin(0.01));
+			REQUIRE(s.rotation == Approx(r.rotation).margin(0.01));
+			REQUIRE(s.rotation_speed == Approx(r.rotation_speed).margin(0.01));
+			REQUIRE(s.current_lifetime_ms == r.current_lifetime_ms);
+		}
+	}
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+#include "view/viewables/particle_types.h"
+
+/*
+	General particles of a single layer, stored as a structure of arrays.
+
+	Integration only touches motion and lifetime,
+	so these are kept in flat float arrays apart from what is read only when drawing.
+	The kernels are branchless loops over those arrays so that the compiler vectorizes them.
+*/
+
+class general_particles_soa {
+	struct appearance {
+		assets::image_id image_id;
+		rgba color;
+		vec2i size;
+		float shrink_when_ms_remaining = 0.f;
+		float unshrinking_time_ms = 0.f;
+		int alpha_levels = -1;
+	};
+
+	std::vector<float> pos_x;
+	std::vector<float> pos_y;
+	std::vector<float> vel_x;
+	std::vector<float> vel_y;
+	std::vector<float> acc_x;
+	std::vector<float> acc_y;
+
+	std::vector<float> rotation;
+	std::vector<float> rotation_speed;
+
+	std::vector<float> linear_damping;
+	std::vector<float> angular_damping;
+
+	std::vector<float> current_lifetime_ms;
+	std::vector<float> max_lifetime_ms;
+
+	std::vector<appearance> appearances;
+
+	template <class F>
+	void for_each_array(F&& callback);
+
+public:
+	using value_type = general_particle;
+	static constexpr std::size_t max_particles = general_particle::statically_allocate;
+
+	std::size_t size() const {
+		return pos_x.size();
+	}
+
+	bool empty() const {
+		return pos_x.empty();
+	}
+
+	bool full() const {
+		return size() >= max_particles;
+	}
+
+	void clear();
+	void push_back(const general_particle&);
+
+	/* Reassembles a single particle, e.g. to draw it. */
+	general_particle get(std::size_t i) const;
+
+	/* Safe to call concurrently for disjoint ranges. */
+	void integrate(std::size_t from, std::size_t to, float dt);
+
+	/* Keeps the order of the survivors, so that overlapping particles do not swap their draw order. */
+	void remove_dead();
+};
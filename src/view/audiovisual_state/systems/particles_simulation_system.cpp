@@ -176,7 +176,7 @@ void particles_simulation_system::clear() {
 void particles_simulation_system::add_particle(const particle_layer l, const general_particle& p) {
 	auto& v = general_particles[l];
 
-	if (container_full(v)) {
+	if (v.full()) {
 		return;
 	}
 
@@ -343,7 +343,7 @@ void particles_simulation_system::remove_dead_particles(const cosmos& cosm) {
 	};
 
 	for (auto& particle_layer : general_particles) {
-		dead_particles_remover(particle_layer);
+		particle_layer.remove_dead();
 	}
 
 	for (auto& particle_layer : animated_particles) {
@@ -399,32 +399,45 @@ void particles_simulation_system::integrate_and_draw_all_particles(const integra
 	auto generic_integrate = [&anims, delta](const particle_layer, auto& range, int, int from_i, const int till_i, auto&&... args) {
 		using P = typename remove_cref<decltype(range)>::value_type;
 
-		for (; from_i < till_i; ++from_i) {
-			auto& particle = range[from_i];
+		if constexpr(std::is_same_v<P, general_particle>) {
+			range.integrate(from_i, till_i, delta);
+		}
+		else {
+			for (; from_i < till_i; ++from_i) {
+				auto& particle = range[from_i];
 
-			if constexpr(std::is_same_v<P, general_particle>) {
-				particle.integrate(delta);
-			}
-			else if constexpr(std::is_same_v<P, animated_particle>) {
-				particle.integrate(delta, anims);
-			}
-			else if constexpr(std::is_same_v<P, homing_animated_particle>) {
-				particle.integrate(delta, anims, std::forward<decltype(args)>(args)...);
-			}
-			else {
-				static_assert(always_false_v<P>, "Unimplemented!");
+				if constexpr(std::is_same_v<P, animated_particle>) {
+					particle.integrate(delta, anims);
+				}
+				else if constexpr(std::is_same_v<P, homing_animated_particle>) {
+					particle.integrate(delta, anims, std::forward<decltype(args)>(args)...);
+				}
+				else {
+					static_assert(always_false_v<P>, "Unimplemented!");
+				}
 			}
 		}
 	};
 
-	auto generic_draw = [&output_buffers, &game_images, &anims](const particle_layer p, auto& range, const int layer_index, const int from_i, const int till_i, auto&&...) {
+	auto get_particle = [](auto& range, const int i) -> decltype(auto) {
+		using R = remove_cref<decltype(range)>;
+
+		if constexpr(std::is_same_v<R, general_particles_soa>) {
+			return range.get(i);
+		}
+		else {
+			return std::as_const(range[i]);
+		}
+	};
+
+	auto generic_draw = [&output_buffers, &game_images, &anims, get_particle](const particle_layer p, auto& range, const int layer_index, const int from_i, const int till_i, auto&&...) {
 		{
 			auto& target_buffer = output_buffers.diffuse[p];
 
 			auto li = layer_index;
 
 			for (int i = from_i; i < till_i; ++i) {
-				auto& particle = range[i];
+				const auto& particle = get_particle(range, i);
 
 				auto& t1 = target_buffer[2 * li];
 				auto& t2 = target_buffer[2 * li + 1];
@@ -441,7 +454,7 @@ void particles_simulation_system::integrate_and_draw_all_particles(const integra
 			auto li = layer_index;
 
 			for (int i = from_i; i < till_i; ++i) {
-				auto& particle = range[i];
+				const auto& particle = get_particle(range, i);
 
 				auto& t1 = target_buffer[2 * li];
 				auto& t2 = target_buffer[2 * li + 1];
@@ -16,6 +16,7 @@
 #include "view/viewables/particle_effect.h"
 #include "view/audiovisual_state/special_effects_settings.h"
 #include "view/audiovisual_state/particle_triangle_buffers.h"
+#include "view/audiovisual_state/general_particles_soa.h"
 
 class interpolation_system;
 struct randomization;
@@ -165,7 +166,7 @@ public:
 	using make_particle_vector = augs::constant_size_vector<T, T::statically_allocate>;
 
 	/* Particle vectors */
-	per_particle_layer_t<make_particle_vector<general_particle>> general_particles;
+	per_particle_layer_t<general_particles_soa> general_particles;
 	per_particle_layer_t<make_particle_vector<animated_particle>> animated_particles;
 
 	/* Here we must have a vector as we would be forced to allocate memory every time we begin an emission */
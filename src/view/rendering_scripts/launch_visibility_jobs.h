@@ -1,6 +1,85 @@
 #pragma once
+#include <optional>
 #include "view/rendering_scripts/vis_response_to_triangles.h"
 #include "game/enums/filters.h"
+#include "game/detail/physics/physics_queries.h"
+#include "augs/templates/hash_templates.h"
+
+/*
+	Returns a signature of all bodies that could occlude the request,
+	or nothing if any of them is not static - then the result can't be reused.
+	The signature does not depend on the order in which the broadphase reports the fixtures.
+
+	Fixtures are identified by the versioned id of their entity and their index in it,
+	never by address: the block allocator hands the memory of a freed fixture to the next one.
+	The fat AABB only catches a fixture whose geometry changed in place.
+*/
+
+inline std::optional<uint64_t> calc_static_occluders_signature(
+	const cosmos& cosm,
+	const visibility_request& request
+) {
+	const auto si = cosm.get_si();
+	const auto& physics = cosm.get_solvable_inferred().physics;
+
+	/* Slightly more than calc_visibility queries, since it also raycasts along the lengthened bounds. */
+	const auto margin = si.get_meters(2.f);
+
+	const vec2 eye_meters = si.get_meters(request.eye_transform.pos + request.offset);
+	const auto half_vision = si.get_meters(request.queried_rect) / 2 + vec2::square(margin);
+
+	b2AABB aabb;
+	aabb.lowerBound = b2Vec2(eye_meters - half_vision);
+	aabb.upperBound = b2Vec2(eye_meters + half_vision);
+
+	uint64_t signature = 0;
+	uint64_t num_fixtures = 0;
+	bool all_static = true;
+
+	physics.for_each_in_aabb_meters(
+		aabb,
+		request.filter,
+		[&](const b2Fixture& f) {
+			if (f.GetBody()->GetType() != b2_staticBody) {
+				all_static = false;
+				return callback_result::ABORT;
+			}
+
+			const auto& fat_aabb = f.GetAABB(0);
+
+			signature += augs::hash_multiple(
+				cosm.get_versioned(f.GetUserData()),
+				f.index_in_component,
+				fat_aabb.lowerBound.x,
+				fat_aabb.lowerBound.y,
+				fat_aabb.upperBound.x,
+				fat_aabb.upperBound.y
+			);
+
+			++num_fixtures;
+			return callback_result::CONTINUE;
+		}
+	);
+
+	if (!all_static) {
+		return std::nullopt;
+	}
+
+	return augs::hash_multiple(signature, num_fixtures);
+}
+
+inline bool same_visibility_request(const visibility_request& a, const visibility_request& b) {
+	return 
+		a.eye_transform.pos == b.eye_transform.pos
+		&& a.eye_transform.rotation == b.eye_transform.rotation
+		&& a.queried_rect == b.queried_rect
+		&& a.offset == b.offset
+		&& a.color == b.color
+		&& a.filter == b.filter
+		&& a.subject == b.subject
+		&& a.ignore_discontinuities_shorter_than == b.ignore_discontinuities_shorter_than
+	;
+}
 
 inline void enqueue_visibility_jobs(
 	augs::thread_pool& pool,
@@ -27,6 +106,12 @@ inline void enqueue_visibility_jobs(
 		auto& light_triangles_vectors = dedicated[DV::LIGHT_VISIBILITY];
 		light_triangles_vectors.resize(lights_n);
 
+		auto& static_lights = cached_visibility.static_lights;
+
+		for (auto& it : static_lights) {
+			it.second.requested_this_frame = false;
+		}
+
 		for (std::size_t i = 0; i < lights_n; ++i) {
 			const auto& request = light_requests[i];
 			auto& response = light_responses[i];
@@ -38,13 +123,52 @@ inline void enqueue_visibility_jobs(
 
 			auto& triangles = light_triangles_vectors[i].triangles;
 
-			auto light_job = [&cosm, request, &response, &triangles]() {
+			auto batched_request = request;
+			batched_request.batch_raycasts = true;
+
+			cached_light_visibility* cache = nullptr;
+			uint64_t signature = 0;
+
+			if (request.subject.type_id == entity_type_id::of<static_light>()) {
+				if (const auto static_signature = ::calc_static_occluders_signature(cosm, request)) {
+					signature = *static_signature;
+
+					cache = std::addressof(static_lights[request.subject]);
+					cache->requested_this_frame = true;
+
+					const bool still_valid = 
+						cache->computed
+						&& cache->static_occluders_signature == signature
+						&& ::same_visibility_request(cache->request, request)
+					;
+
+					if (still_valid) {
+						response = cache->response;
+						triangles = cache->triangles;
+						continue;
+					}
+
+					cache->computed = false;
+				}
+			}
+
+			auto light_job = [&cosm, request = batched_request, &response, &triangles, cache, signature]() {
 				visibility_system(DEBUG_FRAME_LINES).calc_visibility(cosm, request, response);
 				vis_response_to_triangles(response, triangles, request.color, request.eye_transform.pos);
+
+				if (cache != nullptr) {
+					cache->request = request;
+					cache->static_occluders_signature = signature;
+					cache->response = response;
+					cache->triangles = triangles;
+					cache->computed = true;
+				}
 			};
 
 			pool.enqueue(light_job);
 		}
+
+		erase_if(static_lights, [](const auto& it) { return !it.second.requested_this_frame; });
 	};
 
 	launch_light_jobs();
@@ -57,6 +181,7 @@ inline void enqueue_visibility_jobs(
 		request.filter = predefined_queries::line_of_sight();
 		request.queried_rect = fow_size;
 		request.subject = subject;
+		request.batch_raycasts = true;
 
 		auto& fow_response = cached_visibility.fow_response;
 		auto& fow_triangles = dedicated[D::FOG_OF_WAR].triangles;
@@ -0,0 +1,92 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/image/image.h"
+
+#include "view/viewables/image_definition.h"
+#include "view/viewables/regeneration/neon_maps.h"
+#include "view/viewables/regeneration/neon_map_benchmark.h"
+
+static bool same_pixels(const augs::image& a, const augs::image& b) {
+	if (a.get_size() != b.get_size()) {
+		return false;
+	}
+
+	for (unsigned y = 0; y < a.get_rows(); ++y) {
+		for (unsigned x = 0; x < a.get_columns(); ++x) {
+			if (a.pixel({ x, y }) != b.pixel({ x, y })) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+std::string benchmark_neon_maps(
+	const image_definitions_map& definitions,
+	const augs::path_type& unofficial_project_dir
+) {
+	std::size_t num_images = 0;
+	std::size_t num_failed = 0;
+	std::size_t num_mismatched = 0;
+
+	double fast_ms = 0.0;
+	double reference_ms = 0.0;
+
+	std::string mismatches;
+
+	for (const auto& d : definitions) {
+		const auto& extra = d.meta.extra_loadables;
+
+		if (!extra.should_generate_neon_map()) {
+			continue;
+		}
+
+		const auto def = image_definition_view(unofficial_project_dir, d);
+		const auto source_path = def.get_source_image_path();
+		const auto& in = extra.generate_neon_map.value;
+
+		augs::image source;
+
+		try {
+			source.from_file(source_path);
+		}
+		catch (...) {
+			++num_failed;
+			continue;
+		}
+
+		++num_images;
+
+		auto fast = source;
+		auto reference = source;
+
+		{
+			augs::timer t;
+			make_neon(in, fast);
+			fast_ms += t.get<std::chrono::milliseconds>();
+		}
+
+		{
+			augs::timer t;
+			make_neon_reference(in, reference);
+			reference_ms += t.get<std::chrono::milliseconds>();
+		}
+
+		if (!same_pixels(fast, reference)) {
+			++num_mismatched;
+			mismatches += typesafe_sprintf("Mismatch: %x\n", source_path);
+		}
+	}
+
+	std::string report;
+
+	report += typesafe_sprintf("Neon maps: %x images (%x failed to load)\n", num_images, num_failed);
+	report += typesafe_sprintf("make_neon: %f2 ms\n", fast_ms);
+	report += typesafe_sprintf("make_neon_reference: %f2 ms\n", reference_ms);
+	report += typesafe_sprintf("Speedup: %f2x\n", reference_ms / std::max(fast_ms, 1e-9));
+	report += typesafe_sprintf("Mismatched: %x\n", num_mismatched);
+	report += mismatches;
+
+	return report;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include "augs/filesystem/path_declaration.h"
+#include "view/viewables/all_viewables_declaration.h"
+
+/*
+	Generates the neon maps of all given images in memory,
+	once with make_neon and once with make_neon_reference,
+	and reports the time spent in each along with the number of images where they differ.
+
+	Nothing is written to the cache.
+*/
+
+std::string benchmark_neon_maps(
+	const image_definitions_map& definitions,
+	const augs::path_type& unofficial_project_dir
+);
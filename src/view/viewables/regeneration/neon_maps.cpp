@@ -1,4 +1,6 @@
 #include <sstream>
+#include <limits>
+#include <algorithm>
 
 #include "augs/filesystem/file.h"
 #include "augs/filesystem/directory.h"
@@ -16,11 +18,6 @@
 
 #define PIXEL_NONE rgba(0,0,0,0)
 
-void make_neon(
-	const neon_map_input& input,
-	augs::image& source
-);
-
 std::optional<cached_neon_map_in> should_regenerate_neon_map(
 	const augs::path_type& input_image_path,
 	const augs::path_type& output_image_path,
@@ -115,45 +112,83 @@ void resize_image(
 
 void cut_empty_edges(augs::image& source);
 
-/* Thread local usage actually makes this slower, I have no idea why. */
+struct neon_kernel_alphas {
+	std::vector<rgba_channel> by_index;
+	std::vector<rgba_channel> by_squared_distance;
 
-void make_neon(
+	/* Offsets of the light from the drawn pixel, where the alpha is non-zero. */
+	vec2i min_offset;
+	vec2i max_offset;
+
+	bool any() const {
+		return min_offset.x <= max_offset.x;
+	}
+};
+
+static void calc_kernel_alphas(
 	const neon_map_input& input,
-	augs::image& source
+	const std::vector<double>& kernel,
+	neon_kernel_alphas& out
 ) {
 	const auto radius = input.radius;
+	const auto half = vec2i(radius / 2);
 
-	resize_image(source, radius);
+	out.by_index.resize(kernel.size());
+	out.by_squared_distance.assign(std::size_t(half.x * half.x + half.y * half.y + 1), 0);
 
-	thread_local std::vector<double> kernel_;
-	thread_local std::vector<vec2u> pixel_coordinates_;
-	thread_local std::vector<rgba> pixels_original_;
+	out.min_offset = vec2i(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+	out.max_offset = vec2i(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
 
-	auto& kernel = kernel_;
-	auto& pixel_coordinates = pixel_coordinates_;
-	auto& pixels_original = pixels_original_; 
+	for (unsigned y = 0; y < radius.y; ++y) {
+		for (unsigned x = 0; x < radius.x; ++x) {
+			const auto i = y * radius.x + x;
+			const auto alpha = static_cast<rgba_channel>(std::min(255u, static_cast<unsigned>(255 * kernel[i] * input.amplification)));
 
-	pixel_coordinates.clear();
-	pixels_original.clear();
+			out.by_index[i] = alpha;
 
-	scan_and_hide_undesired_pixels(source, input.light_colors, pixel_coordinates);
-	generate_gauss_kernel(input, kernel);
+			const auto offset = vec2i(int(x), int(y)) - half;
+			const auto d2 = std::size_t(offset.x * offset.x + offset.y * offset.y);
 
-	for (const auto& p : pixel_coordinates) {
-		pixels_original.emplace_back(source.pixel(p));
+			/* The kernel is radial, so equal distances always have equal alphas. */
+			out.by_squared_distance[d2] = alpha;
+
+			if (alpha > 0) {
+				out.min_offset.x = std::min(out.min_offset.x, offset.x);
+				out.min_offset.y = std::min(out.min_offset.y, offset.y);
+				out.max_offset.x = std::max(out.max_offset.x, offset.x);
+				out.max_offset.y = std::max(out.max_offset.y, offset.y);
+			}
+		}
 	}
+}
+
+/*
+	Draws the glow of every light in order, blending colors where glows of different lights meet.
+	Only visits the offsets where the kernel alpha is non-zero.
+*/
+
+static void splat_lights(
+	const neon_map_input& input,
+	const neon_kernel_alphas& alphas,
+	const std::vector<vec2u>& pixel_coordinates,
+	const std::vector<rgba>& pixels_original,
+	augs::image& source
+) {
+	const auto radius = input.radius;
+	const auto half = vec2i(radius / 2);
 
-	const auto radius_rows = radius.y;
-	const auto radius_cols = radius.x;
 	const auto source_rows = source.get_rows();
 	const auto source_cols = source.get_columns();
 
+	const auto first = alphas.min_offset + half;
+	const auto last = alphas.max_offset + half;
+
 	for (std::size_t i = 0; i < pixel_coordinates.size(); ++i) {
 		const auto coord = pixel_coordinates[i];
 		const auto current_light_pixel = pixels_original[i];
 
-		for (unsigned y = 0; y < radius_rows; ++y) {
-			for (unsigned x = 0; x < radius_cols; ++x) {
+		for (unsigned y = first.y; y <= unsigned(last.y); ++y) {
+			for (unsigned x = first.x; x <= unsigned(last.x); ++x) {
 				const unsigned current_index_y = coord.y + y - radius.y / 2;
 
 				if (current_index_y >= source_rows) {
@@ -166,7 +201,7 @@ void make_neon(
 					continue;
 				}
 
-				if (const auto alpha = std::min(255u, static_cast<unsigned>(255 * kernel[y * radius_cols + x] * input.amplification))) {
+				if (const auto alpha = alphas.by_index[y * radius.x + x]) {
 					auto& drawn_pixel = source.pixel({ current_index_x, current_index_y });
 
 					if (drawn_pixel == PIXEL_NONE) {
@@ -186,6 +221,176 @@ void make_neon(
 			}
 		}
 	}
+}
+
+/*
+	If all lights have the same color, blending never changes the color,
+	and the alpha of a pixel is the kernel alpha of its nearest light.
+
+	Since the kernel decreases with the distance,
+	it is enough to find the squared distance to the nearest light within the kernel window.
+	That is separable: a vertical pass finds the nearest light in every column,
+	then a horizontal pass takes the minimum over neighbouring columns.
+	Both passes run over whole rows so that the compiler vectorizes them.
+*/
+
+static void separable_single_color_lights(
+	const neon_kernel_alphas& alphas,
+	const std::vector<vec2u>& pixel_coordinates,
+	const rgba light_color,
+	augs::image& source
+) {
+	constexpr int far_away = 1 << 28;
+
+	const auto w = int(source.get_columns());
+	const auto h = int(source.get_rows());
+
+	const auto min_o = alphas.min_offset;
+	const auto max_o = alphas.max_offset;
+
+	thread_local std::vector<uint8_t> lit;
+	thread_local std::vector<int> nearest_in_column;
+	thread_local std::vector<int> last_lit_y;
+	thread_local std::vector<int> padded_row;
+	thread_local std::vector<int> distances;
+
+	lit.assign(std::size_t(w) * h, 0);
+
+	for (const auto& p : pixel_coordinates) {
+		lit[std::size_t(p.y) * w + p.x] = 1;
+	}
+
+	nearest_in_column.resize(std::size_t(w) * h);
+	last_lit_y.resize(w);
+
+	/* The light lies above the drawn pixel, offset.y >= 0. */
+
+	std::fill(last_lit_y.begin(), last_lit_y.end(), -far_away);
+
+	for (int y = 0; y < h; ++y) {
+		const auto* const lit_row = lit.data() + std::size_t(y) * w;
+		auto* const out_row = nearest_in_column.data() + std::size_t(y) * w;
+
+		for (int x = 0; x < w; ++x) {
+			last_lit_y[x] = lit_row[x] ? y : last_lit_y[x];
+
+			const auto d = y - last_lit_y[x];
+			out_row[x] = d <= max_o.y ? d * d : far_away;
+		}
+	}
+
+	/* The light lies below the drawn pixel, offset.y <= 0. */
+
+	std::fill(last_lit_y.begin(), last_lit_y.end(), 2 * far_away);
+
+	for (int y = h - 1; y >= 0; --y) {
+		const auto* const lit_row = lit.data() + std::size_t(y) * w;
+		auto* const out_row = nearest_in_column.data() + std::size_t(y) * w;
+
+		for (int x = 0; x < w; ++x) {
+			last_lit_y[x] = lit_row[x] ? y : last_lit_y[x];
+
+			const auto d = last_lit_y[x] - y;
+			out_row[x] = std::min(out_row[x], -d >= min_o.y ? d * d : far_away);
+		}
+	}
+
+	/* The drawn pixel at x is reached by a light in column x - offset.x. */
+
+	const auto pad_left = std::max(0, max_o.x);
+	const auto pad_right = std::max(0, -min_o.x);
+
+	padded_row.assign(std::size_t(pad_left + w + pad_right), far_away);
+	distances.resize(w);
+
+	const auto max_d2 = int(alphas.by_squared_distance.size()) - 1;
+
+	for (int y = 0; y < h; ++y) {
+		const auto* const column_row = nearest_in_column.data() + std::size_t(y) * w;
+		std::copy(column_row, column_row + w, padded_row.begin() + pad_left);
+
+		std::fill(distances.begin(), distances.end(), far_away);
+
+		for (int ox = min_o.x; ox <= max_o.x; ++ox) {
+			const auto* const from = padded_row.data() + pad_left - ox;
+			const auto ox2 = ox * ox;
+
+			for (int x = 0; x < w; ++x) {
+				distances[x] = std::min(distances[x], from[x] + ox2);
+			}
+		}
+
+		const auto* const lit_row = lit.data() + std::size_t(y) * w;
+
+		for (int x = 0; x < w; ++x) {
+			const auto d2 = distances[x];
+
+			if (d2 > max_d2 || lit_row[x]) {
+				/* Lights are restored afterwards anyway. */
+				continue;
+			}
+
+			if (const auto alpha = alphas.by_squared_distance[d2]) {
+				auto& drawn_pixel = source.pixel({ unsigned(x), unsigned(y) });
+
+				drawn_pixel = light_color;
+				drawn_pixel[3] = alpha;
+			}
+		}
+	}
+}
+
+static void make_neon(
+	const neon_map_input& input,
+	augs::image& source,
+	const bool force_splatting_whole_kernel
+) {
+	const auto radius = input.radius;
+
+	resize_image(source, radius);
+
+	thread_local std::vector<double> kernel_;
+	thread_local std::vector<vec2u> pixel_coordinates_;
+	thread_local std::vector<rgba> pixels_original_;
+	thread_local neon_kernel_alphas alphas_;
+
+	auto& kernel = kernel_;
+	auto& pixel_coordinates = pixel_coordinates_;
+	auto& pixels_original = pixels_original_; 
+	auto& alphas = alphas_;
+
+	pixel_coordinates.clear();
+	pixels_original.clear();
+
+	scan_and_hide_undesired_pixels(source, input.light_colors, pixel_coordinates);
+	generate_gauss_kernel(input, kernel);
+	calc_kernel_alphas(input, kernel, alphas);
+
+	for (const auto& p : pixel_coordinates) {
+		pixels_original.emplace_back(source.pixel(p));
+	}
+
+	if (force_splatting_whole_kernel) {
+		alphas.min_offset = -vec2i(radius / 2);
+		alphas.max_offset = vec2i(radius) - vec2i(radius / 2) - vec2i(1, 1);
+	}
+
+	if (alphas.any() && pixels_original.size() > 0) {
+		const auto first_color = pixels_original[0];
+
+		const bool single_color = std::all_of(
+			pixels_original.begin(),
+			pixels_original.end(),
+			[first_color](const rgba c) { return c == first_color; }
+		);
+
+		if (single_color && !force_splatting_whole_kernel) {
+			separable_single_color_lights(alphas, pixel_coordinates, first_color, source);
+		}
+		else {
+			splat_lights(input, alphas, pixel_coordinates, pixels_original, source);
+		}
+	}
 
 	for (std::size_t i = 0; i < pixel_coordinates.size(); ++i) {
 		source.pixel(pixel_coordinates[i]) = pixels_original[i];
@@ -198,6 +403,20 @@ void make_neon(
 	}
 }
 
+void make_neon(
+	const neon_map_input& input,
+	augs::image& source
+) {
+	make_neon(input, source, false);
+}
+
+void make_neon_reference(
+	const neon_map_input& input,
+	augs::image& source
+) {
+	make_neon(input, source, true);
+}
+
 void generate_gauss_kernel(const neon_map_input& input, std::vector<double>& result) {
 	const auto radius = input.radius;
 	const auto rows = radius.y;
@@ -346,3 +565,48 @@ void cut_empty_edges(augs::image& source) {
 
 	source = std::move(copy);
 }
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("NeonMaps MatchReference") {
+	neon_map_input in;
+	in.radius = { 31u, 17u };
+	in.standard_deviation = 4.f;
+	in.amplification = 200.f;
+	in.alpha_multiplier = 0.7f;
+	in.light_colors = { rgba(255, 0, 0, 255), rgba(0, 255, 40, 255), rgba(10, 20, 200, 128) };
+
+	for (int lights_n : { 1, 3 }) {
+		augs::image source;
+		source.resize_fill({ 40u, 30u });
+
+		for (unsigned y = 0; y < 30; ++y) {
+			for (unsigned x = 0; x < 40; ++x) {
+				const auto h = (x * 7 + y * 13) % 23;
+
+				if (h < 4) {
+					source.pixel({ x, y }) = in.light_colors[(x + y) % lights_n];
+				}
+				else if (h < 6) {
+					source.pixel({ x, y }) = rgba(1, 2, 3, 255);
+				}
+			}
+		}
+
+		auto fast = source;
+		auto reference = source;
+
+		make_neon(in, fast);
+		make_neon_reference(in, reference);
+
+		REQUIRE(fast.get_size() == reference.get_size());
+
+		for (unsigned y = 0; y < fast.get_rows(); ++y) {
+			for (unsigned x = 0; x < fast.get_columns(); ++x) {
+				REQUIRE(fast.pixel({ x, y }) == reference.pixel({ x, y }));
+			}
+		}
+	}
+}
+#endif
@@ -8,6 +8,10 @@
 #include "augs/filesystem/path.h"
 #include "augs/filesystem/file_time_type.h"
 
+namespace augs {
+	class image;
+}
+
 struct neon_map_input {
 	// GEN INTROSPECTOR struct neon_map_input
 	float standard_deviation = 6.f;
@@ -48,4 +52,22 @@ void regenerate_neon_map(
 	const augs::path_type& output_image_path,
 	const neon_map_input in,
 	cached_neon_map_in
+);
+
+/*
+	Replaces the image with its neon map.
+	Images whose lights are all of the same color take a separable path
+	that gives the same pixels as make_neon_reference.
+*/
+
+void make_neon(
+	const neon_map_input& in,
+	augs::image& source
+);
+
+/* Draws the whole kernel around every light in order. Kept as a reference for tests and benchmarks. */
+
+void make_neon_reference(
+	const neon_map_input& in,
+	augs::image& source
 );
\ No newline at end of file
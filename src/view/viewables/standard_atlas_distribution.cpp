@@ -213,11 +213,15 @@ general_atlas_output create_general_atlas(
 	thread_local baked_atlas baked;
 	baked.clear();
 
+	/* Switching between maps mostly adds images, so keep the previous layout around. */
+	static atlas_packing_cache packing_cache;
+
 	bake_fresh_atlas(
 		{
 			atlas_subjects,
 			in.max_atlas_size,
-			in.subjects.settings.atlas_blitting_threads
+			in.subjects.settings.atlas_blitting_threads,
+			std::addressof(packing_cache)
 		},
 		{
 			in.atlas_image_output,
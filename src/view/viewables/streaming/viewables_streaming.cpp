@@ -8,16 +8,15 @@
 
 #include "augs/audio/audio_command_buffers.h"
 #include "augs/audio/audio_backend.h"
+#include "augs/audio/sound_data.h"
 #include "view/viewables/regeneration/atlas_progress_structs.h"
 #include "augs/misc/imgui/imgui_control_wrappers.h"
 #include "augs/misc/imgui/imgui_scope_wrappers.h"
 #include "augs/filesystem/file.h"
 #include "augs/filesystem/directory.h"
-#include "augs/misc/compress.h"
 #include "augs/readwrite/byte_file.h"
-#include "augs/readwrite/to_bytes.h"
-#include "application/setups/client/demo_file_meta.h"
 #include "augs/misc/scope_guard.h"
+#include "all_paths.h"
 
 #if PLATFORM_WEB && !WEB_SINGLETHREAD
 #include "augs/templates/main_thread_queue.h"
@@ -26,6 +25,57 @@
 void web_sdk_loading_start();
 void web_sdk_loading_stop();
 
+#define DECODED_SOUNDS_CACHE_DIR (CACHE_DIR / "decoded_sounds")
+
+/* Past this size, the least recently used decoded sounds are removed. */
+constexpr uint64_t max_decoded_sounds_cache_bytes = 1024ull * 1024 * 1024;
+
+static bool is_long_sound(const augs::path_type& path) {
+#if PLATFORM_WEB
+	(void)path;
+	return false;
+#else
+	/* Roughly a minute of a typical OGG. */
+	constexpr std::size_t long_sound_min_bytes = 1024 * 1024;
+
+	if (path.extension() != ".ogg") {
+		return false;
+	}
+
+	try {
+		return static_cast<std::size_t>(augs::get_file_size(path)) >= long_sound_min_bytes;
+	}
+	catch (...) {
+		return false;
+	}
+#endif
+}
+
+template <class R, class F>
+static auto load_sound_buffers(const R& requests, F&& on_loaded) {
+	std::vector<std::optional<augs::sound_buffer>> result;
+
+	for (const auto& r : requests) {
+		if (r.second.source_sound.empty()) {
+			/* A request to unload. */
+			result.push_back(std::nullopt);
+			continue;
+		}
+
+		try {
+			augs::sound_buffer b = r.second;
+			result.emplace_back(std::move(b));
+		}
+		catch (...) {
+			result.push_back(std::nullopt);
+		}
+
+		on_loaded();
+	}
+
+	return result;
+}
+
 void viewables_streaming::request_rescan() {
 	if (!general_atlas.empty()) {
 		rescan_for_modified_images = true;
@@ -39,6 +89,10 @@ void viewables_streaming::finalize_pending_tasks() {
 		future_loaded_buffers.get();
 	}
 
+	if (future_loaded_long_buffers.valid()) {
+		future_loaded_long_buffers.get();
+	}
+
 	if (future_general_atlas.valid()) {
 		future_general_atlas.get();
 	}
@@ -274,14 +328,18 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 
 	/* Sounds pass */
 
-	if (!future_loaded_buffers.valid()) {
+	if (!future_loaded_buffers.valid() && !future_loaded_long_buffers.valid()) {
 		auto total = measure_scope(performance.launching_sounds_reload);
 
 		auto make_sound_loading_input = [&](const sound_definition& def) {
 			const auto def_view = sound_definition_view(unofficial_content_dir, def);
 			const auto input = def_view.make_sound_loading_input();
 
-			return input;
+			return augs::sound_buffer_loading_input {
+				input.source_sound,
+				input.settings,
+				DECODED_SOUNDS_CACHE_DIR
+			};
 		};
 
 		auto& now_defs = now_all_defs.sounds;
@@ -297,7 +355,20 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 		/* Gather loading requests for new and changed definitions. */
 		for_each_id_and_object(new_defs, [&](const auto& fresh_key, const auto& new_def) {
 			auto request_new = [&]() {
-				sound_requests.emplace_back(fresh_key, make_sound_loading_input(new_def));
+				auto input = make_sound_loading_input(new_def);
+
+				if (is_long_sound(input.source_sound)) {
+					/* Played straight from the encoded file, so there is nothing to cache. */
+					long_sound_requests.emplace_back(fresh_key, augs::sound_buffer_loading_input {
+						input.source_sound,
+						input.settings,
+						{},
+						true
+					});
+				}
+				else {
+					sound_requests.emplace_back(fresh_key, std::move(input));
+				}
 			};
 
 			if (const auto now_def = mapped_or_nullptr(now_defs, fresh_key)) {
@@ -312,6 +383,12 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 			}
 		});
 
+		if (sound_requests.size() > 0 || long_sound_requests.size() > 0) {
+			in.audio_buffers.finish();
+
+			future_sound_definitions = new_all_defs.sounds;
+		}
+
 		if (sound_requests.size() > 0) {
 			bring_loading_popup_to_front = true;
 
@@ -331,33 +408,12 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 				web_sdk_loading_start();
 				auto scoped_stop = augs::scope_guard([]() { web_sdk_loading_stop(); });
 
-				using value_type = decltype(future_loaded_buffers.get());
-
-				value_type result;
+				auto loaded = load_sound_buffers(sound_requests, [this]() { sounds_progress->current_sound_num += 1; });
+				augs::trim_decoded_sound_cache(DECODED_SOUNDS_CACHE_DIR, max_decoded_sounds_cache_bytes);
 
-				for (const auto& r : sound_requests) {
-					if (r.second.source_sound.empty()) {
-						/* A request to unload. */
-						result.push_back(std::nullopt);
-						continue;
-					}
-
-					try {
-						augs::sound_buffer b = r.second;
-						result.emplace_back(std::move(b));
-					}
-					catch (...) {
-						result.push_back(std::nullopt);
-					}
-
-					sounds_progress->current_sound_num += 1;
-				}
-
-				return result;
+				return loaded;
 			};
 
-			in.audio_buffers.finish();
-
 #if PLATFORM_WEB && !WEB_SINGLETHREAD
 			using V = decltype(future_loaded_buffers.get());
 
@@ -372,8 +428,13 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 #else
 			future_loaded_buffers = launch_async(buffer_loader);
 #endif
+		}
 
-			future_sound_definitions = new_all_defs.sounds;
+		if (long_sound_requests.size() > 0) {
+			/* Only opens the files, so there is nothing to wait for on the popup. */
+			future_loaded_long_buffers = launch_async([this]() {
+				return load_sound_buffers(long_sound_requests, []() {});
+			});
 		}
 
 		rescan_for_modified_sounds = false;
@@ -398,10 +459,6 @@ void texture_in_progress<output_type>::finalize_load(augs::renderer& renderer) {
 }
 
 void viewables_streaming::finalize_load(viewables_finalize_input in) {
-	if (valid_and_is_ready(future_compressed_demos)) {
-		future_compressed_demos.get();
-	}
-
 	if (requested_avatar_preview.has_value()) {
 		augs::image avatar;
 		avatar.from_file(*requested_avatar_preview);
@@ -445,12 +502,7 @@ void viewables_streaming::finalize_load(viewables_finalize_input in) {
 		general_atlas_submitted_when = current_frame;
 	}
 
-	if (valid_and_is_ready(future_loaded_buffers)) {
-		auto& now_loaded_defs = now_all_defs.sounds;
-		auto& new_loaded_defs = future_sound_definitions;
-
-		sounds_progress = std::nullopt;
-
+	auto finalize_sound_requests = [&](const auto& requests, auto loaded) {
 		{
 			thread_local std::unordered_set<ALuint> all_unloaded_buffers;
 
@@ -462,7 +514,7 @@ void viewables_streaming::finalize_load(viewables_finalize_input in) {
 				return found_in(all_unloaded_buffers, buffer_id);
 			};
 
-			for (const auto& r : sound_requests) {
+			for (const auto& r : requests) {
 				if (const auto loaded_sound = mapped_or_nullptr(loaded_sounds, r.first)) {
 					for (const auto& v : loaded_sound->get_variations()) {
 						all_unloaded_buffers.emplace(v.get_id());
@@ -481,106 +533,47 @@ void viewables_streaming::finalize_load(viewables_finalize_input in) {
 
 		/* Reload the sounds that at the time of launch were found to be new or changed. */
 
-		{
-			auto loaded = future_loaded_buffers.get();
+		for (const auto& r : requests) {
+			const auto id = r.first;
+			unload(id);
 
-			for (const auto& r : sound_requests) {
-				const auto id = r.first;
-				unload(id);
-
-				const auto i = index_in(sound_requests, r);
+			const auto i = index_in(requests, r);
 
-				if (auto& loaded_sound = loaded[i]) {
-					/* Loading was successful. */
-					loaded_sounds.try_emplace(id, std::move(loaded_sound.value()));
-				}
+			if (auto& loaded_sound = loaded[i]) {
+				/* Loading was successful. */
+				loaded_sounds.try_emplace(id, std::move(loaded_sound.value()));
 			}
 		}
+	};
+
+	if (valid_and_is_ready(future_loaded_buffers)) {
+		auto& now_loaded_defs = now_all_defs.sounds;
+		auto& new_loaded_defs = future_sound_definitions;
+
+		sounds_progress = std::nullopt;
+
+		finalize_sound_requests(sound_requests, future_loaded_buffers.get());
+
+		/* 
+			Done, overwrite.
+			Long sounds might still be loading - until then, the previous versions keep playing.
+		*/
 
-		/* Done, overwrite */
 		now_loaded_defs = new_loaded_defs;
 		sound_requests.clear();
 	}
-}
 
-bool viewables_streaming::general_atlas_in_progress() const {
-	return general_atlas_progress.has_value();
-}
+	if (valid_and_is_ready(future_loaded_long_buffers)) {
+		finalize_sound_requests(long_sound_requests, future_loaded_long_buffers.get());
 
-void viewables_streaming::wait_demos_compressed() {
-	if (future_compressed_demos.valid()) {
-		future_compressed_demos.get();
+		/* There might have been no short sounds to load along with these. */
+		now_all_defs.sounds = future_sound_definitions;
+		long_sound_requests.clear();
 	}
 }
 
-void viewables_streaming::recompress_demos() {
-	future_compressed_demos = launch_async([]() {
-		std::vector<augs::path_type> file_list;
-
-		augs::for_each_in_directory(
-			augs::path_type(DEMOS_DIR),
-			[](auto&&...) { return callback_result::CONTINUE; },
-			[&file_list](const augs::path_type& demo) {
-				if (demo.extension() == ".dem") {
-					file_list.push_back(demo);
-				}
-
-				return callback_result::CONTINUE;
-			}
-		);
-
-		if (file_list.size() > 0) {
-			LOG("%x demos to be compressed.", file_list.size());
-		}
-		else {
-			LOG("All demos are already compressed.");
-		}
-
-		auto state = augs::make_compression_state();
-
-		for (const auto& demo_path : file_list) {
-			LOG("Compressing: %x", demo_path);
-			auto contents = augs::file_to_bytes(demo_path);
-
-			demo_file_meta meta;
-
-			auto s = augs::make_ptr_read_stream(contents);
-			try {
-				augs::read_bytes(s, meta);
-			}
-			catch (...) {
-				/* Broken/deprecated demo. Just delete it and move on. */
-
-				augs::remove_file(demo_path);
-				continue;
-			}
-
-			const auto pos = s.get_read_pos();
-
-			if (pos == contents.size()) {
-				LOG("Demo was empty.");
-				continue;
-			}
-
-			meta.uncompressed_size = contents.size() - pos;
-			auto compressed = augs::to_bytes(meta);
-
-			augs::compress(
-				state,
-				contents.data() + pos,
-				contents.size() - pos,
-				compressed
-			);
-
-			auto new_path = demo_path;
-			new_path.replace_extension(".demc");
-
-			augs::bytes_to_file(compressed, new_path);
-			augs::remove_file(demo_path);
-		}
-
-		return true;
-	});
+bool viewables_streaming::general_atlas_in_progress() const {
+	return general_atlas_progress.has_value();
 }
 
 bool viewables_streaming::is_loading_sounds() const {
@@ -667,12 +660,5 @@ void viewables_streaming::display_loading_progress() const {
 	}
 	else {
 		bring_loading_popup_to_front = true;
-
-		if (future_compressed_demos.valid()) {
-			center_next_window(ImGuiCond_Always);
-			auto loading_window = scoped_window("Demo file compression in progress", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
-
-			text_color("The game is compressing demo files. Please be patient.\n", yellow);
-		}
 	}
 }
@@ -81,8 +81,6 @@ struct texture_in_progress {
 };
 
 class viewables_streaming {
-	augs::future<bool> future_compressed_demos;
-
 	std::vector<rgba> general_atlas_pbo_fallback;
 
 	all_loaded_gui_fonts loaded_gui_fonts;
@@ -103,6 +101,14 @@ class viewables_streaming {
 
 	augs::future<std::vector<std::optional<augs::sound_buffer>>> future_loaded_buffers;
 
+	/* 
+		Long sounds like music and ambience are streamed from their encoded files while they play.
+		They are opened in the background without showing the loading popup.
+	*/
+
+	std::vector<std::pair<assets::sound_id, augs::sound_buffer_loading_input>> long_sound_requests;
+	augs::future<std::vector<std::optional<augs::sound_buffer>>> future_loaded_long_buffers;
+
 	std::vector<augs::file_time_type> image_write_times;
 	std::vector<augs::file_time_type> sound_write_times;
 
@@ -156,8 +162,6 @@ public:
 	bool is_loading_sounds() const;
 
 	void request_rescan();
-	void recompress_demos();
-	void wait_demos_compressed();
 
 	auto& get_general_atlas() {
 		return general_atlas;
@@ -79,6 +79,7 @@
 
 #include "augs/graphics/renderer.h"
 #include "augs/graphics/renderer_backend.h"
+#include "augs/graphics/null_renderer_backend.h"
 
 #include "augs/window_framework/shell.h"
 #include "augs/window_framework/window.h"
@@ -120,6 +121,13 @@
 #include "application/input/input_pass_result.h"
 
 #include "application/setups/client/demo_paths.h"
+#if BUILD_NETWORKING && !HEADLESS
+#include "application/setups/client/demo_benchmark.h"
+#endif
+#if !HEADLESS
+#include "view/viewables/regeneration/neon_map_benchmark.h"
+#include "game/detail/physics/explosion_query_benchmark.h"
+#endif
 
 #include "steam_integration_callbacks.h"
 
@@ -725,6 +733,13 @@ work_result work(
 		LOG("Unit tests were disabled.");
 	}
 
+	if (params.benchmark_explosion_queries) {
+		const auto report = benchmark_explosion_queries();
+		LOG("%x", report);
+
+		return work_result::SUCCESS;
+	}
+
 	LOG("Initializing ImGui.");
 
 #if !HEADLESS
@@ -1369,6 +1384,27 @@ work_result work(
 	LOG("Headless build. Nothing to do.");
 	return work_result::SUCCESS;
 #else
+#if BUILD_NETWORKING
+	if (!params.benchmark_demo.empty()) {
+		demo_benchmark_settings settings;
+		settings.demo_path = CALLING_CWD / params.benchmark_demo;
+
+		if (!params.benchmark_report.empty()) {
+			settings.report_path = CALLING_CWD / params.benchmark_report;
+		}
+
+		const bool ok = benchmark_demo(*official, config.client, settings);
+		return ok ? work_result::SUCCESS : work_result::FAILURE;
+	}
+#endif
+
+	if (params.benchmark_neon_maps) {
+		const auto report = benchmark_neon_maps(official->built_content.viewables.image_definitions, augs::path_type());
+		LOG("%x", report);
+
+		return work_result::SUCCESS;
+	}
+
 	WEBSTATIC auto abandon_pending_op = std::optional<ingame_menu_button_type>();
 	WEBSTATIC auto abandon_are_you_sure_popup = std::optional<simple_popup>();
 
@@ -1477,6 +1513,18 @@ work_result work(
 
 	LOG("Initializing the renderer backend.");
 	WEBSTATIC augs::graphics::renderer_backend renderer_backend;
+	WEBSTATIC auto null_renderer_backend = std::optional<augs::graphics::null_renderer_backend>();
+
+#if BUILD_OPENGL
+	if (params.null_renderer) {
+		LOG("--null-renderer specified. Rendering commands will not reach the GPU.");
+		LOG("The window and the GL context are still created. Build with HEADLESS_FRAME_BENCHMARK to run without a display.");
+		null_renderer_backend.emplace();
+	}
+#else
+	/* Without OpenGL, counting the commands is the only thing left to do with them. */
+	null_renderer_backend.emplace();
+#endif
 
 	WEBSTATIC game_frame_buffer_swapper buffer_swapper;
 
@@ -2125,8 +2173,6 @@ work_result work(
 
 			map_catalogue_gui.request_refresh();
 			leaderboards_gui.request_refresh();
-
-			streaming.recompress_demos();
 		}
 	};
 
@@ -2195,8 +2241,6 @@ work_result work(
 
 		LOG("Launching client setup with connect string: %x", connect_string);
 
-		streaming.wait_demos_compressed();
-
 		if (ignore_nat_check) {
 			LOG("Finished NAT traversal. Connecting immediately.");
 		}
@@ -5721,6 +5765,14 @@ work_result work(
 			}
 
 			finalize_frame_and_swap();
+
+			if (params.benchmark_frames > 0 && current_frame.load() >= static_cast<augs::frame_num_type>(params.benchmark_frames)) {
+				std::string report = typesafe_sprintf("Benchmarked %x frames. Game thread:\n", params.benchmark_frames);
+				game_thread_performance.totals_summary(report);
+
+				LOG("%x", report);
+				request_quit();
+			}
 		}
 	};
 
@@ -5811,6 +5863,7 @@ work_result work(
 		augs::window& window;
 		game_frame_buffer_swapper& buffer_swapper;
 		augs::graphics::renderer_backend& renderer_backend;
+		std::optional<augs::graphics::null_renderer_backend>& null_renderer_backend;
 		augs::thread_pool& thread_pool;
 		augs::timer& this_frame_timer;
 		augs::timer& until_first_swap;
@@ -5827,6 +5880,7 @@ work_result work(
 		window,
 		buffer_swapper,
 		renderer_backend,
+		null_renderer_backend,
 		thread_pool,
 		this_frame_timer,
 		until_first_swap,
@@ -5859,6 +5913,7 @@ work_result work(
 		auto& game_main_thread_synced_op = mi.game_main_thread_synced_op;
 		auto& thread_pool = mi.thread_pool;
 		auto& renderer_backend = mi.renderer_backend;
+		auto& null_renderer_backend = mi.null_renderer_backend;
 		auto& window = mi.window;
 
 		auto& this_frame_timer = mi.this_frame_timer;
@@ -5998,6 +6053,17 @@ work_result work(
 				rendering_result.clear();
 
 				for (auto& r : read_buffer.renderers.all) {
+					if (null_renderer_backend.has_value()) {
+						null_renderer_backend->perform(
+							rendering_result,
+							r.commands.data(),
+							r.commands.size(),
+							r.dedicated
+						);
+
+						continue;
+					}
+
 					renderer_backend.perform(
 						rendering_result,
 						r.commands.data(),
@@ -6107,6 +6173,10 @@ work_result work(
 			break;
 		}
 	}
+
+	if (null_renderer_backend.has_value()) {
+		LOG("Null renderer backend totals:\n%x", null_renderer_backend->get_stats().summary());
+	}
 #endif
 
 	return game_thread_result;